@@ -0,0 +1,651 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename analyse.cc
+    @author Shreyas Vinod
+    @version 0.1.5
+
+    @brief Analyses EPD test suites in parallel and reports the results.
+
+    Reads an EPD (Extended Position Description) file, searches every
+    position with a fixed depth, node or time budget on a pool of worker
+    threads, each with its own board and transposition table, and reports
+    the results in JSON or CSV along with the solve rate and time-to-solution.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 EPD files are now read through a FenReader.
+    * 17/10/2026 0.1.2 Hash table allocation failures are reported.
+    * 17/10/2026 0.1.3 parse_epd() finds operations in place with epd_operations() and find_opcode().
+    * 17/10/2026 0.1.4 Fails if no worker can allocate its hash table, and 'keephash' keeps the table between positions.
+    * 17/10/2026 0.1.5 Records with positions parse_fen() rejects are reported as errors.
+*/
+
+/**
+    @file
+    @filename analyse.cc
+    @author Shreyas Vinod
+
+    @brief Analyses EPD test suites in parallel and reports the results.
+
+    Reads an EPD (Extended Position Description) file, searches every
+    position with a fixed depth, node or time budget on a pool of worker
+    threads, each with its own board and transposition table, and reports
+    the results in JSON or CSV along with the solve rate and time-to-solution.
+*/
+
+#include "defs.h"
+
+#include <iostream> // std::cout and std::cerr
+#include <fstream> // std::ofstream
+#include <string> // std::string
+#include <cctype> // isspace()
+#include <vector> // std::vector
+#include <thread> // std::thread
+#include <atomic> // std::atomic
+
+#include "analyse.h"
+#include "board.h"
+#include "move.h" // COORD_MOVE()
+#include "search.h"
+#include "hash_table.h"
+#include "chronos.h" // Time and get_time_diff()
+#include "fen_reader.h"
+
+// Structures
+
+/**
+    @struct AnalyseResult
+
+    @brief Holds the outcome of the analysis of a single EPD record.
+
+    @var AnalyseResult::move
+         The best move found by the search.
+    @var AnalyseResult::score
+         The score of the best move.
+    @var AnalyseResult::depth
+         The depth of the last completed iteration.
+    @var AnalyseResult::nodes
+         The number of nodes searched.
+    @var AnalyseResult::time
+         The time taken by the search in milliseconds.
+    @var AnalyseResult::solve_time
+         The time in milliseconds after which the search settled on the
+         solution, if it was solved.
+    @var AnalyseResult::graded
+         Denotes whether the record has a 'bm' or 'am' opcode to grade the
+         search against.
+    @var AnalyseResult::solved
+         Denotes whether the search found a solution.
+    @var AnalyseResult::error
+         Denotes whether the record could not be parsed, including a
+         position parse_fen() rejects, such as one without a king a side.
+*/
+
+struct AnalyseResult
+{
+    unsigned int move;
+    int score;
+    unsigned int depth;
+    uint64 nodes;
+    uint64 time;
+    uint64 solve_time;
+    bool graded;
+    bool solved;
+    bool error;
+
+    AnalyseResult()
+    :move(NO_MOVE), score(0), depth(0), nodes(0), time(0), solve_time(0),
+        graded(0), solved(0), error(0)
+    {}
+};
+
+// Prototypes
+
+inline void split_operands(const StrSlice& operands,
+    std::vector<std::string>& tokens);
+bool parse_epd(const StrSlice& line, EpdRecord& record);
+inline std::string json_escape(const std::string& str);
+inline std::string csv_escape(const std::string& str);
+void analyse_worker(const std::vector<EpdRecord>& records,
+    std::vector<AnalyseResult>& results, std::atomic<unsigned int>& next,
+    std::atomic<unsigned int>& started, const AnalyseOptions& options);
+void write_json(std::ostream& out, const std::string& epd_file,
+    const std::vector<EpdRecord>& records,
+    const std::vector<AnalyseResult>& results, uint64 wall_time);
+void write_csv(std::ostream& out, const std::vector<EpdRecord>& records,
+    const std::vector<AnalyseResult>& results, uint64 wall_time);
+bool analyse_epd(const std::string& epd_file, const AnalyseOptions& options);
+
+// Function definitions
+
+/**
+    @brief Splits the operands of an EPD operation on whitespace, removing
+           the quotes of quoted operands, which may hold whitespace.
+
+    @param operands is the operands part of an operation, as a slice.
+    @param tokens is the list to append the operands to.
+
+    @return void.
+*/
+
+inline void split_operands(const StrSlice& operands,
+    std::vector<std::string>& tokens)
+{
+    unsigned int i = 0, start;
+
+    while(i < operands.length)
+    {
+        while(i < operands.length && isspace(operands.data[i])) i++;
+        if(i == operands.length) break;
+
+        if(operands.data[i] == '"')
+        {
+            start = ++i;
+            while(i < operands.length && operands.data[i] != '"') i++;
+            tokens.push_back(std::string(operands.data + start, i - start));
+            i++; // Closing quote.
+        }
+        else
+        {
+            start = i;
+            while(i < operands.length && !isspace(operands.data[i])) i++;
+            tokens.push_back(std::string(operands.data + start, i - start));
+        }
+    }
+}
+
+/**
+    @brief Parses a line of an EPD file.
+
+    An EPD line consists of the first four fields of a FEN string, followed
+    by any number of operations, each terminated by a semicolon. Operands
+    may be quoted. Only the 'bm', 'am' and 'id' opcodes are kept, and are
+    found in place, without copying the rest of the line.
+
+    @param line is the line to parse, as a slice.
+    @param record is the record to fill.
+
+    @return bool denoting whether the line held a position.
+
+    @warning The FEN fields are not validated; parse_fen() does that when
+             the record is analysed, and the record is then reported as an
+             error rather than searched.
+*/
+
+bool parse_epd(const StrSlice& line, EpdRecord& record)
+{
+    unsigned int fields = 0, i = 0, start, length = line.length;
+
+    record.fen.clear();
+    record.id.clear();
+    record.best_moves.clear();
+    record.avoid_moves.clear();
+
+    // FEN fields
+
+    while(fields < 4)
+    {
+        while(i < length && isspace(line.data[i])) i++;
+        if(i == length) return 0; // Not enough fields.
+
+        start = i;
+        while(i < length && !isspace(line.data[i])) i++;
+
+        if(fields) record.fen += ' ';
+        record.fen.append(line.data + start, i - start);
+
+        fields++;
+    }
+
+    // Operations
+
+    StrSlice operations = epd_operations(line), operands;
+    std::vector<std::string> tokens;
+
+    if(find_opcode(operations, "bm", operands))
+        split_operands(operands, record.best_moves);
+
+    if(find_opcode(operations, "am", operands))
+        split_operands(operands, record.avoid_moves);
+
+    if(find_opcode(operations, "id", operands))
+    {
+        split_operands(operands, tokens);
+        if(!tokens.empty()) record.id = tokens.at(0);
+    }
+
+    return 1;
+}
+
+/**
+    @brief Escapes a string for use as a JSON string literal.
+
+    @param str is the string to escape.
+
+    @return std::string holding the escaped string, without quotes.
+*/
+
+inline std::string json_escape(const std::string& str)
+{
+    std::string escaped;
+
+    for(unsigned int i = 0; i < str.length(); i++)
+    {
+        if(str[i] == '"' || str[i] == '\\') escaped += '\\';
+        if((unsigned char)str[i] >= 0x20) escaped += str[i];
+    }
+
+    return escaped;
+}
+
+/**
+    @brief Escapes a string for use as a CSV field.
+
+    @param str is the string to escape.
+
+    @return std::string holding the escaped string, quoted if necessary.
+*/
+
+inline std::string csv_escape(const std::string& str)
+{
+    if(str.find_first_of(",\"\n") == std::string::npos) return str;
+
+    std::string escaped = "\"";
+
+    for(unsigned int i = 0; i < str.length(); i++)
+    {
+        if(str[i] == '"') escaped += '"';
+        escaped += str[i];
+    }
+
+    return escaped + "\"";
+}
+
+/**
+    @brief Worker thread for the analysis. Repeatedly takes the next record
+           off the shared queue, searches it and stores the result.
+
+    @param records is the list of records to analyse.
+    @param results is the list of results, indexed like 'records'.
+    @param next is the index of the next record in the queue.
+    @param started is the number of workers that could allocate their
+           hash table, and so took part.
+    @param options is the analysis settings.
+
+    @return void.
+*/
+
+void analyse_worker(const std::vector<EpdRecord>& records,
+    std::vector<AnalyseResult>& results, std::atomic<unsigned int>& next,
+    std::atomic<unsigned int>& started, const AnalyseOptions& options)
+{
+    Board board;
+
+    // A worker without a table takes no records, leaving them to the rest.
+
+    if(!init_table(board.t_table, options.hash_size))
+    {
+        std::cerr << "ERROR: Unable to allocate the hash table." << std::endl;
+        return;
+    }
+
+    started++;
+
+    unsigned int i, fen_index, move;
+    std::vector<unsigned int> best_moves, avoid_moves;
+
+    while((i = next++) < records.size())
+    {
+        const EpdRecord& record = records.at(i);
+        AnalyseResult& result = results.at(i);
+
+        fen_index = 0;
+
+        // A bad position fails this record only, not the whole batch.
+
+        if(!parse_fen(board, record.fen, fen_index))
+        {
+            result.error = 1;
+            continue;
+        }
+
+        // Convert the solutions into moves.
+
+        best_moves.clear();
+        avoid_moves.clear();
+
+        for(unsigned int j = 0; j < record.best_moves.size(); j++)
+        {
+            move = parse_san(board, record.best_moves.at(j));
+            if(move == NO_MOVE) result.error = 1;
+            else best_moves.push_back(move);
+        }
+
+        for(unsigned int j = 0; j < record.avoid_moves.size(); j++)
+        {
+            move = parse_san(board, record.avoid_moves.at(j));
+            if(move == NO_MOVE) result.error = 1;
+            else avoid_moves.push_back(move);
+        }
+
+        if(result.error) continue;
+
+        // Search!
+
+        SearchInfo search_info;
+        search_info.silent = 1;
+        search_info.depth = MAX_DEPTH - 1;
+
+        if(options.depth)
+        {
+            search_info.depth_set = 1;
+            search_info.depth = options.depth;
+        }
+
+        if(options.nodes)
+        {
+            search_info.nodes_set = 1;
+            search_info.max_nodes = options.nodes;
+        }
+
+        if(options.move_time)
+        {
+            search_info.time_set = 1;
+            search_info.move_time = options.move_time;
+        }
+
+        if(!options.keep_hash) clear_table(board.t_table);
+
+        search_info.start_time = get_cur_time();
+        search(board, search_info);
+
+        result.move = search_info.best_move;
+        result.score = search_info.best_score;
+        result.depth = search_info.completed_depth;
+        result.nodes = search_info.nodes;
+        result.time = get_time_diff(search_info.start_time);
+
+        // Grade the move.
+
+        result.graded = !best_moves.empty() || !avoid_moves.empty();
+        result.solved = result.graded && result.move != NO_MOVE;
+
+        if(!best_moves.empty())
+        {
+            bool found = 0;
+
+            for(unsigned int j = 0; j < best_moves.size(); j++)
+                if(best_moves.at(j) == result.move) found = 1;
+
+            if(!found) result.solved = 0;
+        }
+
+        for(unsigned int j = 0; j < avoid_moves.size(); j++)
+            if(avoid_moves.at(j) == result.move) result.solved = 0;
+
+        if(result.solved) result.solve_time = search_info.change_time;
+    }
+
+    free_table(board.t_table);
+}
+
+/**
+    @brief Writes the results of an analysis as a JSON document.
+
+    @param out is the stream to write to.
+    @param epd_file is the name of the EPD file that was analysed.
+    @param records is the list of records analysed.
+    @param results is the list of results, indexed like 'records'.
+    @param wall_time is the time the whole analysis took in milliseconds.
+
+    @return void.
+*/
+
+void write_json(std::ostream& out, const std::string& epd_file,
+    const std::vector<EpdRecord>& records,
+    const std::vector<AnalyseResult>& results, uint64 wall_time)
+{
+    unsigned int graded = 0, solved = 0, errors = 0;
+    uint64 nodes = 0, solve_time = 0;
+
+    for(unsigned int i = 0; i < results.size(); i++)
+    {
+        if(results.at(i).error) errors++;
+        if(results.at(i).graded) graded++;
+        if(results.at(i).solved) solved++;
+        if(results.at(i).solved) solve_time += results.at(i).solve_time;
+        nodes += results.at(i).nodes;
+    }
+
+    out << "{\n";
+    out << "  \"file\": \"" << json_escape(epd_file) << "\",\n";
+    out << "  \"positions\": " << records.size() << ",\n";
+    out << "  \"errors\": " << errors << ",\n";
+    out << "  \"graded\": " << graded << ",\n";
+    out << "  \"solved\": " << solved << ",\n";
+    out << "  \"solve_rate\": " << (graded ? double(solved) / graded : 0.0) <<
+        ",\n";
+    out << "  \"mean_solve_time_ms\": " <<
+        (solved ? double(solve_time) / solved : 0.0) << ",\n";
+    out << "  \"nodes\": " << nodes << ",\n";
+    out << "  \"time_ms\": " << wall_time << ",\n";
+    out << "  \"results\": [";
+
+    for(unsigned int i = 0; i < results.size(); i++)
+    {
+        const EpdRecord& record = records.at(i);
+        const AnalyseResult& result = results.at(i);
+
+        out << (i ? ",\n" : "\n");
+        out << "    {\"line\": " << record.line << ", \"id\": \"" <<
+            json_escape(record.id) << "\", \"fen\": \"" <<
+            json_escape(record.fen) << "\", \"bm\": [";
+
+        for(unsigned int j = 0; j < record.best_moves.size(); j++)
+        {
+            out << (j ? ", \"" : "\"") <<
+                json_escape(record.best_moves.at(j)) << "\"";
+        }
+
+        out << "], \"am\": [";
+
+        for(unsigned int j = 0; j < record.avoid_moves.size(); j++)
+        {
+            out << (j ? ", \"" : "\"") <<
+                json_escape(record.avoid_moves.at(j)) << "\"";
+        }
+
+        out << "], ";
+
+        if(result.error)
+        {
+            out << "\"error\": true}";
+            continue;
+        }
+
+        out << "\"move\": \"" << COORD_MOVE(result.move) << "\", \"score\": " <<
+            result.score << ", \"depth\": " << result.depth << ", \"nodes\": " <<
+            result.nodes << ", \"time_ms\": " << result.time << ", \"solved\": ";
+
+        if(!result.graded) out << "null";
+        else if(result.solved) out << "true";
+        else out << "false";
+
+        out << ", \"solve_time_ms\": ";
+
+        if(result.solved) out << result.solve_time << "}";
+        else out << "null}";
+    }
+
+    out << "\n  ]\n}" << std::endl;
+}
+
+/**
+    @brief Writes the results of an analysis as CSV, with one row per record
+           and the totals in trailing '#' comment lines.
+
+    @param out is the stream to write to.
+    @param records is the list of records analysed.
+    @param results is the list of results, indexed like 'records'.
+    @param wall_time is the time the whole analysis took in milliseconds.
+
+    @return void.
+*/
+
+void write_csv(std::ostream& out, const std::vector<EpdRecord>& records,
+    const std::vector<AnalyseResult>& results, uint64 wall_time)
+{
+    unsigned int graded = 0, solved = 0, errors = 0;
+    uint64 nodes = 0, solve_time = 0;
+    std::string moves;
+
+    out << "line,id,fen,bm,am,move,score,depth,nodes,time_ms,solved," <<
+        "solve_time_ms\n";
+
+    for(unsigned int i = 0; i < results.size(); i++)
+    {
+        const EpdRecord& record = records.at(i);
+        const AnalyseResult& result = results.at(i);
+
+        if(result.error) errors++;
+        if(result.graded) graded++;
+        if(result.solved) solved++;
+        if(result.solved) solve_time += result.solve_time;
+        nodes += result.nodes;
+
+        out << record.line << "," << csv_escape(record.id) << "," <<
+            csv_escape(record.fen) << ",";
+
+        moves.clear();
+
+        for(unsigned int j = 0; j < record.best_moves.size(); j++)
+            moves += (j ? " " : "") + record.best_moves.at(j);
+
+        out << csv_escape(moves) << ",";
+
+        moves.clear();
+
+        for(unsigned int j = 0; j < record.avoid_moves.size(); j++)
+            moves += (j ? " " : "") + record.avoid_moves.at(j);
+
+        out << csv_escape(moves) << ",";
+
+        if(result.error)
+        {
+            out << ",,,,,error,\n";
+            continue;
+        }
+
+        out << COORD_MOVE(result.move) << "," << result.score << "," <<
+            result.depth << "," << result.nodes << "," << result.time << ",";
+
+        if(!result.graded) out << ",";
+        else if(result.solved) out << "1," << result.solve_time;
+        else out << "0,";
+
+        out << "\n";
+    }
+
+    out << "# positions " << records.size() << "\n";
+    out << "# errors " << errors << "\n";
+    out << "# solved " << solved << "/" << graded << " (" <<
+        (graded ? (100.0 * solved) / graded : 0.0) << "%)\n";
+    out << "# mean_solve_time_ms " <<
+        (solved ? double(solve_time) / solved : 0.0) << "\n";
+    out << "# nodes " << nodes << "\n";
+    out << "# time_ms " << wall_time << std::endl;
+}
+
+/**
+    @brief Analyses every position in an EPD file on a pool of worker threads
+           and writes the results.
+
+    @param epd_file is the path of the EPD file to analyse.
+    @param options is the analysis settings.
+
+    @return bool denoting whether the analysis ran, that is, whether the EPD
+            and output files could be opened and at least one worker could
+            allocate its hash table. No results are written otherwise.
+
+    @warning Each worker allocates its own transposition table of
+             'options.hash_size' bytes.
+*/
+
+bool analyse_epd(const std::string& epd_file, const AnalyseOptions& options)
+{
+    FenReader epd;
+
+    if(!open_reader(epd, epd_file))
+    {
+        std::cerr << "ERROR: Unable to open EPD file \"" << epd_file << "\"." <<
+            std::endl;
+        return 0;
+    }
+
+    // Read the records.
+
+    std::vector<EpdRecord> records;
+    EpdRecord record;
+    StrSlice line;
+
+    while(next_line(epd, line))
+    {
+        if(!parse_epd(line, record)) continue;
+
+        record.line = epd.line;
+        records.push_back(record);
+    }
+
+    close_reader(epd);
+
+    AnalyseOptions opts = options;
+
+    if(!opts.depth && !opts.nodes && !opts.move_time) opts.move_time = 1000;
+    if(opts.threads == 0) opts.threads = 1;
+    if(opts.threads > records.size()) opts.threads = records.size();
+
+    std::ofstream out_file;
+
+    if(!opts.out_file.empty())
+    {
+        out_file.open(opts.out_file);
+
+        if(!out_file.is_open())
+        {
+            std::cerr << "ERROR: Unable to open output file \"" <<
+                opts.out_file << "\"." << std::endl;
+            return 0;
+        }
+    }
+
+    std::ostream& out = opts.out_file.empty() ? std::cout : out_file;
+
+    // Spread the records across the workers.
+
+    std::vector<AnalyseResult> results(records.size());
+    std::vector<std::thread> workers;
+    std::atomic<unsigned int> next(0), started(0);
+
+    Time begin = get_cur_time();
+
+    for(unsigned int i = 0; i < opts.threads; i++)
+    {
+        workers.push_back(std::thread(analyse_worker, std::cref(records),
+            std::ref(results), std::ref(next), std::ref(started),
+            std::cref(opts)));
+    }
+
+    for(unsigned int i = 0; i < workers.size(); i++) workers.at(i).join();
+
+    uint64 wall_time = get_time_diff(begin);
+
+    // If no worker could start, no record was searched.
+
+    if(!records.empty() && started == 0) return 0;
+
+    if(opts.format == FORMAT_CSV) write_csv(out, records, results, wall_time);
+    else write_json(out, epd_file, records, results, wall_time);
+
+    return 1;
+}
@@ -0,0 +1,139 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename analyse.h
+    @author Shreyas Vinod
+    @version 0.1.3
+
+    @brief Analyses EPD test suites in parallel and reports the results.
+
+    Reads an EPD (Extended Position Description) file, searches every
+    position with a fixed depth, node or time budget on a pool of worker
+    threads, each with its own board and transposition table, and reports
+    the results in JSON or CSV along with the solve rate and time-to-solution.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 parse_epd() now takes a StrSlice.
+    * 17/10/2026 0.1.2 AnalyseOptions::hash_size is 64-bit.
+    * 17/10/2026 0.1.3 Added AnalyseOptions::keep_hash.
+*/
+
+/**
+    @file
+    @filename analyse.h
+    @author Shreyas Vinod
+
+    @brief Analyses EPD test suites in parallel and reports the results.
+
+    Reads an EPD (Extended Position Description) file, searches every
+    position with a fixed depth, node or time budget on a pool of worker
+    threads, each with its own board and transposition table, and reports
+    the results in JSON or CSV along with the solve rate and time-to-solution.
+*/
+
+#ifndef ANALYSE_H
+#define ANALYSE_H
+
+#include "defs.h"
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+// Enumerations
+
+enum { FORMAT_JSON, FORMAT_CSV }; // Output formats.
+
+// Structures
+
+/**
+    @struct EpdRecord
+
+    @brief Holds a single position of an EPD file along with the opcodes
+           the analysis cares about.
+
+    @var EpdRecord::fen
+         The position, as the four mandatory FEN fields.
+    @var EpdRecord::id
+         The position identifier given by the 'id' opcode, if any.
+    @var EpdRecord::best_moves
+         The operands of the 'bm' (best move) opcode, in SAN.
+    @var EpdRecord::avoid_moves
+         The operands of the 'am' (avoid move) opcode, in SAN.
+    @var EpdRecord::line
+         The line number of the record in the EPD file.
+*/
+
+struct EpdRecord
+{
+    std::string fen;
+    std::string id;
+    std::vector<std::string> best_moves;
+    std::vector<std::string> avoid_moves;
+    unsigned int line;
+
+    EpdRecord()
+    :fen(), id(), best_moves(), avoid_moves(), line(0)
+    {}
+};
+
+/**
+    @struct AnalyseOptions
+
+    @brief Holds the settings for an analysis run.
+
+    @var AnalyseOptions::depth
+         The depth to search every position to, or zero if unlimited.
+    @var AnalyseOptions::nodes
+         The node budget per position, or zero if unlimited.
+    @var AnalyseOptions::move_time
+         The time budget per position in milliseconds, or zero if unlimited.
+    @var AnalyseOptions::threads
+         The number of worker threads (and engine instances).
+    @var AnalyseOptions::hash_size
+         The size of each worker's transposition table in bytes.
+    @var AnalyseOptions::keep_hash
+         Denotes whether the transposition table is kept between positions
+         instead of being cleared before each one. Clearing it costs a pass
+         over the whole table per position, which dominates short searches,
+         but keeps results independent of the order positions are searched
+         in.
+    @var AnalyseOptions::format
+         The output format; FORMAT_JSON or FORMAT_CSV.
+    @var AnalyseOptions::out_file
+         The file to write results to, or an empty string for standard
+         output.
+
+    @warning If no depth, node or time budget is set, every position is
+             searched for one second.
+*/
+
+struct AnalyseOptions
+{
+    unsigned int depth;
+    uint64 nodes;
+    uint64 move_time;
+    unsigned int threads;
+    uint64 hash_size;
+    bool keep_hash;
+    unsigned int format;
+    std::string out_file;
+
+    AnalyseOptions()
+    :depth(0), nodes(0), move_time(0), threads(1), hash_size(16777216),
+        keep_hash(0), format(FORMAT_JSON), out_file()
+    {}
+};
+
+// External function declarations
+
+// Parse a line of an EPD file.
+
+extern bool parse_epd(const StrSlice& line, EpdRecord& record);
+
+// Analyse every position in an EPD file and report the results.
+
+extern bool analyse_epd(const std::string& epd_file,
+    const AnalyseOptions& options);
+
+#endif // ANALYSE_H
@@ -0,0 +1,131 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename bench.cc
+    @author Shreyas Vinod
+    @version 0.1.1
+
+    @brief Runs a fixed-depth search benchmark over a set of positions.
+
+    Searches a built-in list of positions to a fixed depth and reports the
+    node count of each along with the total node count, time taken and
+    speed. The total node count doubles as a signature of the search, since
+    it only changes when the search itself does.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 Hash table allocation failures are reported.
+*/
+
+/**
+    @file
+    @filename bench.cc
+    @author Shreyas Vinod
+
+    @brief Runs a fixed-depth search benchmark over a set of positions.
+
+    Searches a built-in list of positions to a fixed depth and reports the
+    node count of each along with the total node count, time taken and
+    speed. The total node count doubles as a signature of the search, since
+    it only changes when the search itself does.
+*/
+
+#include "defs.h"
+
+#include <iostream> // std::cout and std::cerr
+
+#include "bench.h"
+#include "board.h"
+#include "move.h"
+#include "search.h"
+#include "hash_table.h"
+#include "chronos.h"
+
+// Globals
+
+// The benchmark positions.
+
+const char* bench_fens[] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1",
+    "r1b1k2r/ppppnppp/2n2q2/2b5/3NP3/2P1B3/PP3PPP/RN1QKB1R w KQkq - 0 1",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/3N4 b - - 0 1",
+    "8/8/8/8/5kp1/P7/8/1K1N4 w - - 0 1"
+};
+
+// Prototypes
+
+uint64 run_bench(unsigned int depth, uint64 hash_size);
+
+// Function definitions
+
+/**
+    @brief Searches every benchmark position to the given depth, from an empty
+           transposition table each time, and prints a line per position
+           followed by a summary line.
+
+    @param depth is the depth in ply to search each position to.
+    @param hash_size is the size of the transposition table in bytes.
+
+    @return uint64 value denoting the total number of nodes searched, or zero
+            if a benchmark position could not be parsed.
+
+    @warning Output lines are of the form 'position <n> nodes <n> bestmove
+             <move>', followed by 'bench nodes <n> time <ms> nps <n>'.
+*/
+
+uint64 run_bench(unsigned int depth, uint64 hash_size)
+{
+    Board board;
+    if(!init_table(board.t_table, hash_size))
+    {
+        std::cerr << "ERROR: Unable to allocate the hash table." << std::endl;
+        return 0;
+    }
+
+    uint64 total_nodes = 0;
+    Time begin = get_cur_time();
+    unsigned int num_fens = sizeof(bench_fens) / sizeof(bench_fens[0]);
+
+    for(unsigned int n = 0; n < num_fens; n++)
+    {
+        unsigned int i = 0;
+
+        if(!parse_fen(board, bench_fens[n], i))
+        {
+            free_table(board.t_table);
+            return 0; // Parse error.
+        }
+
+        SearchInfo search_info;
+        search_info.silent = 1;
+        search_info.depth_set = 1;
+        search_info.depth = depth;
+
+        clear_table(board.t_table);
+        search_info.start_time = get_cur_time();
+        search(board, search_info);
+
+        total_nodes += search_info.nodes;
+
+        std::cout << "position " << n + 1 << " nodes " << search_info.nodes <<
+            " bestmove " << COORD_MOVE(search_info.best_move) << std::endl;
+    }
+
+    uint64 elapsed = get_time_diff(begin);
+
+    std::cout << "bench nodes " << total_nodes << " time " << elapsed <<
+        " nps " << (total_nodes * 1000) / (elapsed ? elapsed : 1) << std::endl;
+
+    free_table(board.t_table);
+
+    return total_nodes;
+}
@@ -0,0 +1,45 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename bench.h
+    @author Shreyas Vinod
+    @version 0.1.0
+
+    @brief Runs a fixed-depth search benchmark over a set of positions.
+
+    Searches a built-in list of positions to a fixed depth and reports the
+    node count of each along with the total node count, time taken and
+    speed. The total node count doubles as a signature of the search, since
+    it only changes when the search itself does.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+*/
+
+/**
+    @file
+    @filename bench.h
+    @author Shreyas Vinod
+
+    @brief Runs a fixed-depth search benchmark over a set of positions.
+
+    Searches a built-in list of positions to a fixed depth and reports the
+    node count of each along with the total node count, time taken and
+    speed. The total node count doubles as a signature of the search, since
+    it only changes when the search itself does.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "defs.h"
+
+#define BENCH_DEPTH 6 // The default benchmark depth.
+
+// External function declarations
+
+// Run the benchmark and return the total number of nodes searched.
+
+extern uint64 run_bench(unsigned int depth, uint64 hash_size);
+
+#endif // BENCH_H
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename board.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.8
 
     @brief Handles the board representation for the engine.
 
@@ -66,6 +66,15 @@
     * 06/12/2015 0.4.7 Added board_flipv(Board&).
     * 06/12/2015 0.4.8 pretty_board(Board&) now prints evaluation score.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added parse_san(Board&, std::string).
+    * 17/10/2026 1.0.2 parse_fen() now parses from a StrSlice without copying.
+    * 17/10/2026 1.0.3 Added is_in_check(Board&) and is_drawn(Board&).
+    * 17/10/2026 1.0.4 probe_pv_line() now validates moves with is_pseudo_legal().
+        * Removed move_exists(Board&, unsigned int).
+    * 17/10/2026 1.0.5 Removed probe_pv_line(Board&, unsigned int).
+    * 17/10/2026 1.0.6 Added has_game_cycle(const Board&, unsigned int).
+    * 17/10/2026 1.0.7 parse_fen() rejects bad en passant squares and king counts.
+    * 17/10/2026 1.0.8 parse_fen() reads the full move number into Board::start_ply.
 */
 
 /**
@@ -99,7 +108,8 @@
 // Prototypes
 
 void reset_board(Board& board);
-bool parse_fen(Board& board, const std::string fen, unsigned int& i);
+bool parse_fen(Board& board, const StrSlice& fen, unsigned int& i);
+inline char fen_char(const StrSlice& fen, unsigned int i);
 unsigned int determine_type(const Board& board, uint64 bit_chk);
 char conv_char(const Board& board, unsigned int index);
 std::string pretty_board(Board& board);
@@ -116,9 +126,11 @@ void undo_move(Board& board);
 void make_null_move(Board& board);
 void undo_null_move(Board& board);
 unsigned int parse_move(Board& board, std::string str_move);
-inline bool move_exists(Board& board, unsigned int move);
-unsigned int probe_pv_line(Board& board, unsigned int depth);
+unsigned int parse_san(Board& board, std::string str_move);
 void board_flipv(Board& board);
+bool is_in_check(const Board& board);
+bool is_drawn(const Board& board);
+bool has_game_cycle(const Board& board, unsigned int ply);
 
 // Function definitions
 
@@ -139,6 +151,7 @@ void reset_board(Board& board)
 
     board.ply = 0;
     board.his_ply = 0;
+    board.start_ply = 0;
 
     board.castle_perm = 0; // Defaults to zero.
 
@@ -160,26 +173,28 @@ void reset_board(Board& board)
     the given board structure.
 
     @param board is the board to initialise with the FEN string.
-    @param fen is the FEN string.
+    @param fen is the FEN string, as a slice, so it may be parsed straight
+           out of a larger buffer without being copied.
     @param i is the integer holding where the string is currently pointing to.
 
     @return bool value representing whether initialisation was
             successful.
 
-    @warning Do NOT have more than king for each side. Although this is not
-             checked, the consequence of having multiple kings is undefined for
-             the engine in its entirety. It just won't work.
+    @warning Fails unless each side has exactly one king, and unless the
+             en passant square, if any, is on the sixth rank with white to
+             move or the third with black to move.
     @warning Do NOT place pawns on ranks one or eight. This is an
              impossible occurrence, and the engine will fail to promote them.
              In fact, they might vanish, I don't really know.
     @warning Assumes ASCII.
     @warning This will reset 'board'.
+    @warning Trailing characters after the FEN fields are ignored.
     @warning Please check if the function returns 1, else the initialisation
              failed, and you shouldn't hit your head on the wall like I did,
              trying to figure out what went wrong.
 */
 
-bool parse_fen(Board& board, const std::string fen, unsigned int& i)
+bool parse_fen(Board& board, const StrSlice& fen, unsigned int& i)
 {
     int file = FILE_A, rank = RANK_8, piece, count;
     char c;
@@ -188,7 +203,7 @@ bool parse_fen(Board& board, const std::string fen, unsigned int& i)
 
     // Pieces
 
-    while((rank >= RANK_1) && (c = fen[i]))
+    while((rank >= RANK_1) && (c = fen_char(fen, i)))
     {
         if(isalpha(c))
         {
@@ -209,6 +224,8 @@ bool parse_fen(Board& board, const std::string fen, unsigned int& i)
                 default: return 0; // Parse error.
             }
 
+            if(file > FILE_H) return 0; // Too many squares on this rank.
+
             board.chessboard[piece] |= B_FILE[file] & B_RANK[rank];
             file++;
         }
@@ -229,21 +246,23 @@ bool parse_fen(Board& board, const std::string fen, unsigned int& i)
 
     // Side
 
-    if((c = fen[i]) == 'w') board.side = WHITE;
+    if((c = fen_char(fen, i)) == 'w') board.side = WHITE;
     else if(c == 'b') board.side = BLACK;
     else return 0; // Parse error.
 
+    board.start_ply = (board.side == BLACK); // Move one, until told otherwise.
+
     i++;
-    if(fen[i] != ' ') return 0; // Parse error.
+    if(fen_char(fen, i) != ' ') return 0; // Parse error.
     i++;
 
     // Castling permissions
 
     count = 0; // Used to make sure the loop isn't crazy, due to incorrect FEN.
 
-    if(fen[i] != '-') // Castling permissions exist.
+    if(fen_char(fen, i) != '-') // Castling permissions exist.
     {
-        while((c = fen[i]) != ' ')
+        while((c = fen_char(fen, i)) != ' ')
         {
             if(count == 4) return 0; // Parse error.
 
@@ -266,57 +285,66 @@ bool parse_fen(Board& board, const std::string fen, unsigned int& i)
 
     // En passant square
 
-    if((c = fen[i]) != '-') // En passant square exists.
+    if((c = fen_char(fen, i)) != '-') // En passant square exists.
     {
         if(isalpha(c)) file = c - 'a' + 1; // Integer value for file.
         else return 0; // Parse error.
 
         i++;
 
-        if(isdigit(c = fen[i])) rank = c - '1' + 1; // Integer value for rank.
+        // Integer value for rank.
+
+        if(isdigit(c = fen_char(fen, i))) rank = c - '1' + 1;
         else return 0;
 
-        assert(file >= FILE_A && file <= FILE_H);
-        assert(rank >= RANK_1 && rank <= RANK_8);
+        if(file < FILE_A || file > FILE_H) return 0; // Off the board.
+
+        // The square a pawn just skipped, so behind the side not to move.
+
+        if(rank != (board.side == WHITE ? RANK_6 : RANK_3)) return 0;
 
         board.en_pas_sq = GET_INDEX(file, rank);
     }
 
     // Optional counter initialisation
 
-    int num, temp;
+    unsigned int num;
 
-    if(((i + 2) < fen.length()) && isdigit(fen[i + 2]))
+    if(isdigit(fen_char(fen, i + 2)))
     {
         // Fifty-move rule counter
 
         i += 2;
 
-        num = std::stoi(fen.substr(i));
+        for(num = 0; isdigit(fen_char(fen, i)); i++)
+            num = (num * 10) + (fen_char(fen, i) - '0');
 
-        temp = num;
-        while((temp /= 10) != 0) i++;
+        i--; // Leave 'i' on the last digit.
 
         board.fifty = num;
 
         // Move counter
 
-        if(((i + 2) < fen.length()) && isdigit(fen[i + 2]))
+        if(isdigit(fen_char(fen, i + 2)))
         {
             i += 2;
 
-            num = std::stoi(fen.substr(i));
+            for(num = 0; isdigit(fen_char(fen, i)); i++)
+                num = (num * 10) + (fen_char(fen, i) - '0');
 
-            temp = num;
-            while((temp /= 10) != 0) i++;
+            i--; // Leave 'i' on the last digit.
 
-            // if(board.side == WHITE) board.his_ply = (num * 2) - 2;
-            // else board.his_ply = (num * 2) - 1;
+            // The history starts here, so the move number only offsets it.
 
-            board.his_ply = 0; // History ply ignored for now.
+            if(num > 0) board.start_ply += (num - 1) * 2;
         }
     }
 
+    // Move generation and evaluation expect exactly one king a side.
+
+    if(CNT_BITS(board.chessboard[wK]) != 1 ||
+        CNT_BITS(board.chessboard[bK]) != 1) return 0;
+
     update_secondary(board); // Update 'all white' and 'all black' boards.
 
     board.hash_key = gen_hash(board); // Generate zobrist hash.
@@ -324,6 +352,21 @@ bool parse_fen(Board& board, const std::string fen, unsigned int& i)
     return 1;
 }
 
+/**
+    @brief Returns a character of a FEN slice, or a null character if the
+           index runs past the end of the slice.
+
+    @param fen is the FEN slice.
+    @param i is the index of the character.
+
+    @return char at index 'i', or '\0' if out of bounds.
+*/
+
+inline char fen_char(const StrSlice& fen, unsigned int i)
+{
+    return (i < fen.length) ? fen.data[i] : '\0';
+}
+
 /**
     @brief Determines the type of pieces occupying a cell.
 
@@ -1101,74 +1144,149 @@ unsigned int parse_move(Board& board, std::string str_move)
 }
 
 /**
-    @brief Checks if the given move actually exists on the board.
+    @brief Converts a string representation of a move in standard algebraic
+           notation (SAN), as used by EPD and PGN files, into the standard
+           convention for representing moves in the engine.
 
-    @param board is the board to check on.
-    @param move is the integer representation of the move to check in
-           standard convention.
+    Check, checkmate and annotation symbols are ignored. Both 'O-O' and
+    '0-0' are accepted for castling, and promotions may be written with or
+    without an '=' sign.
+
+    @param board is the board the move is being made on.
+    @param str_move is the string representation of the move in standard
+           algebraic notation.
 
-    @return bool denoting whether the move exists on the board represented
-            by 'board'.
+    @return unsigned int value representing the move in standard convention.
+
+    @warning Returns 'NO_MOVE' (0) on failure to parse, or if the move does
+             not exist or is not legal.
+    @warning Ambiguous moves resolve to the first legal match.
 */
 
-inline bool move_exists(Board& board, unsigned int move)
+unsigned int parse_san(Board& board, std::string str_move)
 {
-    unsigned int list_move, list_size;
+    unsigned int piece = (board.side == WHITE) ? wP : bP; // Moving piece.
+    unsigned int prom_type = EMPTY; // Type of promoted piece, if any.
+    unsigned int dep_file = NONE, dep_rank = 0; // Disambiguation, if any.
+    unsigned int dst_cell, list_size, list_move; // Temporary variables.
+    bool side = board.side;
+    char c; // Temporary character.
 
-    MoveList ml = gen_moves(board);
+    // Strip check, checkmate and annotation symbols.
 
-    list_size = ml.list.size();
+    while(!str_move.empty() && (str_move.back() == '+' ||
+        str_move.back() == '#' || str_move.back() == '!' ||
+        str_move.back() == '?'))
+    {
+        str_move.pop_back();
+    }
 
-    for(unsigned int i = 0; i < list_size; i++) // Compare with every move.
+    // Castling
+
+    if(str_move == "O-O" || str_move == "0-0" ||
+        str_move == "O-O-O" || str_move == "0-0-0")
     {
-        list_move = ml.list.at(i).move;
+        piece = (side == WHITE) ? wK : bK;
 
-        if(!make_move(board, list_move)) continue;
-        undo_move(board);
-        if(move == list_move) return 1;
+        if(str_move.length() == 3) dst_cell = (side == WHITE) ? g1 : g8;
+        else dst_cell = (side == WHITE) ? c1 : c8;
+
+        str_move.clear();
     }
+    else
+    {
+        if(str_move.length() < 2) return NO_MOVE; // Parse error.
 
-    return 0;
-}
+        // Type of moving piece
 
-/**
-    @brief Retrieves a PV line from the table.
+        switch(str_move[0])
+        {
+            case 'K': piece = (side == WHITE) ? wK : bK; break;
+            case 'Q': piece = (side == WHITE) ? wQ : bQ; break;
+            case 'R': piece = (side == WHITE) ? wR : bR; break;
+            case 'B': piece = (side == WHITE) ? wB : bB; break;
+            case 'N': piece = (side == WHITE) ? wN : bN; break;
+            default: break; // Pawn move.
+        }
 
-    @param board is the board on which to probe and fill the PV array on.
-    @param depth is the depth to which to probe the PV line to.
+        if(piece != wP && piece != bP) str_move.erase(0, 1);
 
-    @return unsigned int value representing the depth to which the PV line
-            was found (or in other words, the number of moves found).
-*/
+        // Type of promoted piece
 
-unsigned int probe_pv_line(Board& board, unsigned int depth)
-{
-    assert(board.ply == 0);
-    assert(depth < MAX_DEPTH);
+        c = str_move.back();
+
+        if((piece == wP || piece == bP) &&
+            (c == 'Q' || c == 'R' || c == 'B' || c == 'N' ||
+            c == 'q' || c == 'r' || c == 'b' || c == 'n'))
+        {
+            switch(c)
+            {
+                case 'Q':
+                case 'q': prom_type = (side == WHITE) ? wQ : bQ; break;
+                case 'R':
+                case 'r': prom_type = (side == WHITE) ? wR : bR; break;
+                case 'B':
+                case 'b': prom_type = (side == WHITE) ? wB : bB; break;
+                case 'N':
+                case 'n': prom_type = (side == WHITE) ? wN : bN; break;
+                default: return NO_MOVE; // Parse error.
+            }
+
+            str_move.pop_back();
+            if(!str_move.empty() && str_move.back() == '=') str_move.pop_back();
+        }
 
-    unsigned int move = probe_pv_table(board.t_table, board.hash_key);
-    unsigned int count = 0;
+        // Destination cell
 
-    // Probe the table.
+        if(str_move.length() < 2) return NO_MOVE; // Parse error.
 
-    while(move != NO_MOVE && count < depth)
+        c = str_move[str_move.length() - 2]; // Destination file
+
+        if(c >= 'a' && c <= 'h') dst_cell = c - 'a';
+        else return NO_MOVE; // Parse error.
+
+        c = str_move[str_move.length() - 1]; // Destination rank
+
+        if(c >= '1' && c <= '8') dst_cell += (c - '1') * 8;
+        else return NO_MOVE; // Parse error.
+
+        str_move.erase(str_move.length() - 2);
+    }
+
+    // Disambiguation and capture symbols
+
+    for(unsigned int i = 0; i < str_move.length(); i++)
     {
-        if(move_exists(board, move))
-        {
-            make_move(board, move);
-            board.pv_array[count] = move;
-            count++;
-        }
-        else break;
+        c = str_move[i];
 
-        move = probe_pv_table(board.t_table, board.hash_key);
+        if(c >= 'a' && c <= 'h') dep_file = c - 'a' + 1;
+        else if(c >= '1' && c <= '8') dep_rank = c - '1' + 1;
+        else if(c != 'x' && c != ':' && c != '-') return NO_MOVE; // Parse error.
     }
 
-    // Reset the board to the original position.
+    MoveList ml = gen_moves(board);
+
+    list_size = ml.list.size();
 
-    while(board.ply > 0) undo_move(board);
+    for(unsigned int i = 0; i < list_size; i++) // Compare with every move.
+    {
+        list_move = ml.list.at(i).move;
 
-    return count;
+        if(DST_CELL(list_move) != dst_cell) continue;
+        if(PROMOTED(list_move) != prom_type) continue;
+        if(dep_file && GET_FILE(DEP_CELL(list_move)) != dep_file) continue;
+        if(dep_rank && GET_RANK(DEP_CELL(list_move)) != dep_rank) continue;
+        if(determine_type(board, GET_BB(DEP_CELL(list_move))) != piece)
+            continue;
+
+        if(make_move(board, list_move)) // Check if legal.
+        {
+            undo_move(board);
+            return list_move;
+        }
+    }
+
+    return NO_MOVE;
 }
 
 /**
@@ -1230,4 +1348,128 @@ void board_flipv(Board& board)
     update_secondary(board); // Update 'all white' and 'all black' boards.
 
     board.hash_key = gen_hash(board); // Generate zobrist hash.
-}
\ No newline at end of file
+}
+
+/**
+    @brief Checks whether the side to move is in check.
+
+    @param board is the board to check.
+
+    @return bool denoting whether the side to move is in check.
+*/
+
+bool is_in_check(const Board& board)
+{
+    uint64 king_bb = board.chessboard[board.side == WHITE ? wK : bK];
+
+    assert((king_bb != 0ULL) && ((king_bb & (king_bb - 1)) == 0ULL));
+
+    return is_sq_attacked(POP_BIT(king_bb), board.side, board);
+}
+
+/**
+    @brief Checks whether the game is drawn by the fifty-move rule, threefold
+           repetition or insufficient material.
+
+    @param board is the board to check.
+
+    @return bool denoting whether the game is drawn.
+
+    @warning Only repetitions within the move history of the board are
+             detected.
+*/
+
+bool is_drawn(const Board& board)
+{
+    if(board.fifty >= 100) return 1;
+
+    // Threefold repetition
+
+    unsigned int repetitions = 0;
+    int start = board.his_ply - board.fifty;
+
+    for(int i = (start > 0 ? start : 0); i < int(board.his_ply); i++)
+        if(board.history.at(i).hash_key == board.hash_key) repetitions++;
+
+    if(repetitions >= 2) return 1;
+
+    // Insufficient material (bare kings, or a single minor piece).
+
+    if(board.chessboard[wP] | board.chessboard[bP] | board.chessboard[wR] |
+        board.chessboard[bR] | board.chessboard[wQ] | board.chessboard[bQ])
+        return 0;
+
+    return CNT_BITS(board.chessboard[wN] | board.chessboard[bN] |
+        board.chessboard[wB] | board.chessboard[bB]) <= 1;
+}
+
+/**
+    @brief Checks whether the side to move has a reversible move that returns
+           to a position from earlier in the game or search, or whether the
+           opponent had one earlier in the search, so that a draw by
+           repetition can be claimed a ply before it happens.
+
+    Every position at an odd distance of three plies or more, back to the
+    last irreversible move, is compared with the current one. If the change
+    in hash key between them is in the cuckoo tables, a single move of a
+    piece other than a pawn connects them, and it only has to be checked
+    that nothing stands in its way.
+
+    @param board is the board to check.
+    @param ply is the number of plies since the root of the search.
+
+    @return bool denoting whether a repetition can be forced.
+
+    @warning Positions before a null move are not considered.
+*/
+
+bool has_game_cycle(const Board& board, unsigned int ply)
+{
+    const unsigned int end = board.fifty < board.his_ply ? board.fifty :
+        board.his_ply;
+
+    if(end < 3) return 0;
+
+    const uint64 occ = board.chessboard[ALL_WHITE] |
+        board.chessboard[ALL_BLACK];
+
+    unsigned int index, move, dep_cell, dst_cell, piece;
+    uint64 move_key;
+
+    for(unsigned int i = 1; i <= end; i++)
+    {
+        const UndoMove& undo = board.history[board.his_ply - i];
+
+        if(undo.move == NO_MOVE) return 0; // Null move.
+
+        if(i < 3 || !(i & 1)) continue;
+
+        move_key = board.hash_key ^ undo.hash_key;
+
+        index = CUCKOO_H1(move_key);
+
+        if(CUCKOO_KEYS[index] != move_key)
+        {
+            index = CUCKOO_H2(move_key);
+            if(CUCKOO_KEYS[index] != move_key) continue;
+        }
+
+        move = CUCKOO_MOVES[index];
+        dep_cell = DEP_CELL(move);
+        dst_cell = DST_CELL(move);
+
+        if(BETWEEN_BB(dep_cell, dst_cell) & occ) continue;
+
+        if(ply > i) return 1; // The repetition is within the search.
+
+        // Otherwise the move must be the side to move's. Both directions of a
+        // move share a slot, so the piece may be on either cell.
+
+        piece = determine_type(board, GET_BB(occ & GET_BB(dep_cell) ?
+            dep_cell : dst_cell));
+
+        if((board.side == WHITE) == (piece <= wK)) return 1;
+    }
+
+    return 0;
+}
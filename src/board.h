@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename board.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.8
 
     @brief Handles the board representation for the engine.
 
@@ -66,6 +66,15 @@
     * 06/12/2015 0.4.7 Added board_flipv(Board&).
     * 06/12/2015 0.4.8 pretty_board(Board&) now prints evaluation score.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added parse_san(Board&, std::string).
+    * 17/10/2026 1.0.2 parse_fen() now parses from a StrSlice without copying.
+    * 17/10/2026 1.0.3 Added is_in_check(Board&) and is_drawn(Board&).
+    * 17/10/2026 1.0.4 Added the per-ply excluded move array.
+    * 17/10/2026 1.0.5 Added the per-ply static evaluation array.
+    * 17/10/2026 1.0.6 Added the triangular PV table.
+        * Removed probe_pv_line(Board&, unsigned int).
+    * 17/10/2026 1.0.7 Added has_game_cycle(const Board&, unsigned int).
+    * 17/10/2026 1.0.8 Added Board::start_ply, the half-moves played before the history starts.
 */
 
 /**
@@ -153,6 +162,9 @@ struct UndoMove
          The number of half-moves in the current search.
     @var Board::his_ply
          The number of half-moves in the history of the game.
+    @var Board::start_ply
+         The number of half-moves played before the position the history
+         starts from, as given by the full move number of its FEN.
     @var Board::castle_perm
          Stores castling permissions for both sides efficiently.
     @var Board::en_pas_sq
@@ -172,11 +184,22 @@ struct UndoMove
     @var Board::t_table
          The transposition hash table.
     @var Board::pv_array
-         Stores the current best PV line obtained from the transposition table.
+         Stores the PV line of the last completed search iteration.
+    @var Board::pv_table
+         The triangular PV table. Row 'ply' holds the best line found from
+         that ply onwards during search.
+    @var Board::pv_length
+         The ply one past the last move of each row of 'pv_table'.
     @var Board::search_history
          An array used for the history heuristic in move ordering.
     @var Board::search_killers
          An array used for the killer heuristic in move ordering.
+    @var Board::excluded
+         The move excluded from the search at each ply, if any, as used by
+         singular extensions.
+    @var Board::static_evals
+         The static evaluation of the position at each ply of the search, or
+         -INFINITY_C if the side to move was in check.
 
     @warning Do NOT have more than king for each side. Although this is not
              checked, the consequence of having multiple kings is undefined for
@@ -221,6 +244,7 @@ struct Board
 
     unsigned int ply; // Number of half-moves in the current search.
     unsigned int his_ply; // Number of half-moves in the history of the game.
+    unsigned int start_ply; // Half-moves played before the history starts.
 
     unsigned int castle_perm; // Castle permissions.
 
@@ -236,13 +260,17 @@ struct Board
 
     TranspositionTable t_table; // Principal Variation (PV) hash table.
     unsigned int pv_array[MAX_DEPTH]; // PV line array.
+    unsigned int pv_table[MAX_DEPTH][MAX_DEPTH]; // Triangular PV table.
+    unsigned int pv_length[MAX_DEPTH]; // End of each row of the PV table.
 
     unsigned int search_history[12][64]; // Array for history heuristics.
     unsigned int search_killers[2][MAX_DEPTH]; // Array for killer heuristics.
+    unsigned int excluded[MAX_DEPTH]; // Move excluded from search, per ply.
+    int static_evals[MAX_DEPTH]; // Static evaluation, per ply.
 
     Board()
-    :side(WHITE), ply(0), his_ply(0), castle_perm(15), en_pas_sq(NO_SQ),
-        fifty(0), hash_key(0ULL), history(), t_table()
+    :side(WHITE), ply(0), his_ply(0), start_ply(0), castle_perm(15),
+        en_pas_sq(NO_SQ), fifty(0), hash_key(0ULL), history(), t_table()
     {
         history.reserve(256);
 
@@ -261,13 +289,18 @@ struct Board
         }
 
         for(unsigned int i = 0; i < MAX_DEPTH; i++)
+        {
             pv_array[i] = 0;
+            pv_length[i] = 0;
+            excluded[i] = NO_MOVE;
+            static_evals[i] = 0;
+        }
     }
 
     Board(bool s, unsigned int p, unsigned int hp, unsigned int cp,
         unsigned int enpsq, unsigned int f, uint64 hk)
-    :side(s), ply(p), his_ply(hp), castle_perm(cp), en_pas_sq(enpsq),
-        fifty(f), hash_key(hk), history(), t_table()
+    :side(s), ply(p), his_ply(hp), start_ply(0), castle_perm(cp),
+        en_pas_sq(enpsq), fifty(f), hash_key(hk), history(), t_table()
     {
         history.reserve(256);
 
@@ -286,7 +319,12 @@ struct Board
         }
 
         for(unsigned int i = 0; i < MAX_DEPTH; i++)
+        {
             pv_array[i] = 0;
+            pv_length[i] = 0;
+            excluded[i] = NO_MOVE;
+            static_evals[i] = 0;
+        }
     }
 };
 
@@ -317,7 +355,17 @@ extern void reset_board(Board& board); // Resets the board.
 
 // Parse FEN
 
-extern bool parse_fen(Board& board, const std::string fen, unsigned int& i);
+extern bool parse_fen(Board& board, const StrSlice& fen, unsigned int& i);
+
+/**
+    @brief Parses a FEN string held in a std::string (or a string literal).
+           See parse_fen(Board&, const StrSlice&, unsigned int&).
+*/
+
+inline bool parse_fen(Board& board, const std::string& fen, unsigned int& i)
+{
+    return parse_fen(board, StrSlice(fen), i);
+}
 
 // Determine type of piece.
 
@@ -340,12 +388,22 @@ extern void undo_null_move(Board& board); // Unmake (undo) the null move.
 
 extern unsigned int parse_move(Board& board, std::string str_move);
 
-// Probe and fill the PV line array.
+// Parse a move in standard algebraic notation (SAN).
 
-extern unsigned int probe_pv_line(Board& board, unsigned int depth);
+extern unsigned int parse_san(Board& board, std::string str_move);
 
 // Flip board vertically for evaluation purposes.
 
 extern void board_flipv(Board& board);
 
+extern bool is_in_check(const Board& board); // Is the side to move in check?
+
+// Check whether the game is drawn by rule or insufficient material.
+
+extern bool is_drawn(const Board& board);
+
+// Check whether a repetition can be forced, a ply before it happens.
+
+extern bool has_game_cycle(const Board& board, unsigned int ply);
+
 #endif // BOARD_H
\ No newline at end of file
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename cortex.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.15
 
     @brief Holds the main function, which lets the user select between
            command line mode and UCI mode.
@@ -14,6 +14,23 @@
     * 07/12/2015 0.1.2 Added evaluation testing.
     * 07/12/2015 0.1.3 Added the 'perftc <depth>' command.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added the 'analyse <epd file>' command.
+    * 17/10/2026 1.0.2 'testeval' now reads through a FenReader.
+    * 17/10/2026 1.0.3 Added the 'gensfen <output file>' command.
+    * 17/10/2026 1.0.4 Added the 'match <engine> <engine>' command.
+    * 17/10/2026 1.0.5 Added command line use: 'cortex uci | bench | perft | analyse'.
+        * Commands run without prompts and return an exit code.
+    * 17/10/2026 1.0.6 Standard output is now buffered instead of unbuffered.
+    * 17/10/2026 1.0.7 Hash table allocation failures are reported.
+    * 17/10/2026 1.0.8 Command line mode reads commands from the input queue, so searches can be interrupted.
+    * 17/10/2026 1.0.9 Searches in command line mode are interactive, stopped by any input.
+    * 17/10/2026 1.0.10 Numeric command line arguments are range-checked with parse_uint(), instead of overflowing.
+    * 17/10/2026 1.0.11 'gensfen' options are range-checked with parse_uint().
+    * 17/10/2026 1.0.12 'match' options are range-checked, including the SPRT error rates and Elo bounds.
+    * 17/10/2026 1.0.13 Added the 'keephash' option to 'analyse'.
+    * 17/10/2026 1.0.14 'match' checks the search parameters of internal engines.
+        * parse_uint() moved to defs.h.
+    * 17/10/2026 1.0.15 'match' range-checks the resign and draw adjudication counts.
 */
 
 /**
@@ -28,6 +45,9 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <sstream>
+#include <thread>
+#include <cstdlib>
 
 #include "defs.h"
 #include "board.h"
@@ -37,9 +57,16 @@
 #include "evaluate.h"
 #include "hash.h"
 #include "hash_table.h"
+#include "lookup_tables.h" // init_between()
 #include "chronos.h"
 #include "uci.h"
 #include "perft.h"
+#include "analyse.h"
+#include "fen_reader.h"
+#include "selfplay.h"
+#include "match.h"
+#include "bench.h"
+#include "misc.h"
 
 // Begin huge list of FENs.
 
@@ -59,6 +86,10 @@
 
 // End huge list of FENs.
 
+// Exit codes of command line use.
+
+enum { EXIT_OK, EXIT_FAILED, EXIT_USAGE };
+
 // Check if the string contains an integer.
 
 bool has_only_digits(const std::string s)
@@ -66,26 +97,191 @@ bool has_only_digits(const std::string s)
   return (s.find_first_not_of("0123456789") == std::string::npos);
 }
 
+// Parse a decimal number, possibly signed, no smaller than 'min' and no
+// greater than 'max'.
+
+bool parse_decimal(const std::string& s, double min, double max,
+  double& value)
+{
+  char* end = nullptr;
+  value = strtod(s.c_str(), &end);
+
+  return !s.empty() && *end == '\0' && value >= min && value <= max;
+}
+
+/**
+    @brief Parses the arguments of the 'analyse' command.
+
+    @param args is the stream holding the arguments, starting with the path
+           of the EPD file.
+    @param epd_file is the string to store the path of the EPD file in.
+    @param options is the structure to store the analysis options in.
+
+    @return bool denoting whether the arguments were valid.
+*/
+
+bool parse_analyse_args(std::stringstream& args, std::string& epd_file,
+    AnalyseOptions& options)
+{
+    std::string option, value;
+    uint64 number;
+
+    options.threads = std::thread::hardware_concurrency();
+
+    if(!(args >> epd_file)) return 0;
+
+    while(args >> option)
+    {
+        if(option == "json") options.format = FORMAT_JSON;
+        else if(option == "csv") options.format = FORMAT_CSV;
+        else if(option == "out")
+        {
+            if(!(args >> options.out_file)) return 0;
+        }
+        else if(option == "keephash") options.keep_hash = 1;
+        else if(!(args >> value) || !parse_uint(value, ~0ULL, number))
+            return 0;
+        else if(option == "depth" && number < MAX_DEPTH)
+            options.depth = number;
+        else if(option == "nodes") options.nodes = number;
+        else if(option == "time") options.move_time = number;
+        else if(option == "threads" && number >= 1 && number <= 1024)
+            options.threads = number;
+        else if(option == "hash" && number >= 1 && number <= 32768)
+            options.hash_size = number * 1048576;
+        else return 0;
+    }
+
+    return 1;
+}
+
+/**
+    @brief Runs a single command given on the command line and exits, so
+           that scripts can drive the engine without interactive prompts.
+
+    Commands:
+        uci
+        bench [depth]
+        perft <fen | startpos> <depth>
+        analyse <epd file> [options] (see 'helpc analyse')
+
+    @param argc is the number of command line arguments.
+    @param argv holds the command line arguments.
+
+    @return int denoting the exit code; EXIT_OK on success, EXIT_FAILED if
+            the command failed to run and EXIT_USAGE if it was malformed.
+
+    @warning Errors are written to standard error, leaving standard output
+             for results alone.
+*/
+
+int run_command(int argc, char* argv[])
+{
+    std::string cmd = argv[1];
+
+    if(cmd == "uci" && argc == 2)
+    {
+        uci_loop(0); // The GUI sends 'uci' itself.
+        return EXIT_OK;
+    }
+    else if(cmd == "bench" && argc <= 3)
+    {
+        uint64 depth = BENCH_DEPTH;
+
+        if(argc == 3 && !parse_uint(argv[2], MAX_DEPTH - 1, depth))
+            return EXIT_USAGE;
+
+        if(depth == 0) return EXIT_USAGE;
+
+        return run_bench(depth, 16777216) ? EXIT_OK : EXIT_FAILED;
+    }
+    else if(cmd == "perft" && argc >= 4)
+    {
+        std::string fen;
+        uint64 depth;
+
+        for(int a = 2; a < argc - 1; a++) // The FEN may span arguments.
+            fen += std::string(a > 2 ? " " : "") + argv[a];
+
+        if(fen == "startpos") fen = FEN_START;
+        if(!parse_uint(argv[argc - 1], MAX_DEPTH, depth)) return EXIT_USAGE;
+
+        Board board;
+        unsigned int i = 0;
+
+        if(!parse_fen(board, fen, i))
+        {
+            std::cerr << "ERROR: Unable to parse FEN \"" << fen << "\"." <<
+                std::endl;
+            return EXIT_FAILED;
+        }
+
+        Time begin = get_cur_time();
+        uint64 nodes = perform_perft(board, depth);
+        uint64 elapsed = get_time_diff(begin);
+
+        std::cout << "perft depth " << depth << " nodes " << nodes <<
+            " time " << elapsed << " nps " <<
+            (nodes * 1000) / (elapsed ? elapsed : 1) << std::endl;
+
+        return EXIT_OK;
+    }
+    else if(cmd == "analyse" && argc >= 3)
+    {
+        std::string args_str, epd_file;
+        AnalyseOptions options;
+
+        for(int a = 2; a < argc; a++) args_str += std::string(argv[a]) + " ";
+
+        std::stringstream args(args_str);
+
+        if(!parse_analyse_args(args, epd_file, options)) return EXIT_USAGE;
+
+        return analyse_epd(epd_file, options) ? EXIT_OK : EXIT_FAILED;
+    }
+
+    return EXIT_USAGE;
+}
+
 /**
     @brief Main. Has the ability to select between command line mode and UCI
-           mode.
+           mode, or runs a single command given on the command line.
+
+    @param argc is the number of command line arguments.
+    @param argv holds the command line arguments.
 
-    @return Zero on successful program termination, obviously.
+    @return Zero on successful program termination, obviously. See
+            run_command() for the exit codes of command line use.
 */
 
-int main()
+int main(int argc, char* argv[])
 {
-    std::cin.setf(std::ios_base::unitbuf); // Set stdin as unbuffered.
-    std::cout.setf(std::ios_base::unitbuf); // Set stdout as unbuffered.
+    // Output is buffered and flushed at protocol boundaries, such as after
+    // 'bestmove' or 'readyok', rather than after every write.
+
+    std::ios_base::sync_with_stdio(false);
 
     std::string usr_cmd;
 
     // Initialise various aspects of the engine.
 
     init_hash();
+    init_between();
     init_mvv_lva();
     init_evalmasks();
 
+    if(argc > 1) // Command line use.
+    {
+        int code = run_command(argc, argv);
+
+        if(code == EXIT_USAGE)
+            std::cerr << "Usage: cortex [uci | bench [depth] | " <<
+                "perft <fen | startpos> <depth> | " <<
+                "analyse <epd file> [options]]" << std::endl;
+
+        return code;
+    }
+
     std::cout << "Hi, I'm Cortex." << std::endl;
     std::cout << "What mode would you like to enter? ";
 
@@ -95,7 +291,7 @@ int main()
 
         if(usr_cmd == "uci")
         {
-            uci_loop(); // Enter UCI loop.
+            uci_loop(1); // Enter UCI loop.
             return 0;
         }
         else if(usr_cmd == "cmd") break;
@@ -105,7 +301,14 @@ int main()
     std::cout << std::endl;
 
     Board board;
-    init_table(board.t_table, 268435456); // Initialise hash table to 256 MB.
+
+    // Initialise hash table to 256 MB.
+
+    if(!init_table(board.t_table, 268435456))
+    {
+        std::cerr << "ERROR: Unable to allocate the hash table." << std::endl;
+        return EXIT_FAILED;
+    }
 
     unsigned int i = 0;
 
@@ -119,10 +322,21 @@ int main()
     std::cout << "Welcome to command line mode. Please enter 'help' for " <<
         "help." << std::endl;
 
+    // Input goes through the command queue, so that a search can be
+    // interrupted by typing while it runs.
+
+    start_input();
+
     while(1)
     {
-        std::cout << "What can I do for you? ";
-        std::cin >> usr_cmd;
+        std::cout << "What can I do for you? " << std::flush;
+
+        std::string line;
+        next_input(line, 1);
+
+        std::stringstream input(line); // The command and its arguments.
+        if(!(input >> usr_cmd)) continue; // Blank line.
+
         std::cout << std::endl;
 
         if(usr_cmd == "quit") break;
@@ -149,6 +363,9 @@ int main()
             std::cout << "--> perft <depth (ply)>" << std::endl;
             std::cout << "--> perftc <depth (ply)>" << std::endl;
             std::cout << "--> testeval" << std::endl;
+            std::cout << "--> analyse <epd file> [options]" << std::endl;
+            std::cout << "--> gensfen <output file> [options]" << std::endl;
+            std::cout << "--> match <engine> <engine> [options]" << std::endl;
             std::cout << "--> cleartable" << std::endl;
             std::cout << "--> clear" << std::endl;
             std::cout << "--> <move> (type 'move' for helpc)" << std::endl;
@@ -156,7 +373,7 @@ int main()
         }
         else if(usr_cmd == "helpc")
         {
-            std::cin >> string_args;
+            input >> string_args;
 
             if(string_args == "help")
             {
@@ -251,6 +468,52 @@ int main()
                     "file stored at " <<
                     "\"test_suites/strategic_test_suite.epd\"";
             }
+            else if(string_args == "analyse")
+            {
+                std::cout << "Command: analyse <epd file> [depth <ply>] " <<
+                    "[nodes <n>] [time <ms>] [threads <n>] [hash <MB>] " <<
+                    "[keephash] [json | csv] [out <file>]" << std::endl;
+                std::cout << "Search every position in an EPD file on " <<
+                    "a pool of threads and report the best move, score " <<
+                    "and time-to-solution for each, graded against the " <<
+                    "'bm' and 'am' opcodes. Searches for one second per " <<
+                    "position if no budget is given. The hash table is " <<
+                    "cleared before each position, which dominates very " <<
+                    "short searches; 'keephash' skips that, at the cost " <<
+                    "of results depending on search order.";
+            }
+            else if(string_args == "gensfen")
+            {
+                std::cout << "Command: gensfen <output file> [games <n>] " <<
+                    "[depth <ply>] [nodes <n>] [random <ply>] " <<
+                    "[maxply <ply>] [evallimit <cp>] [threads <n>] " <<
+                    "[hash <MB>] [seed <n>]" << std::endl;
+                std::cout << "Play games of self-play on a pool of " <<
+                    "threads, opening with random moves, and append " <<
+                    "quiet positions labelled with their search score " <<
+                    "and the game result to a file of packed positions. " <<
+                    "Searches to depth six if no budget is given.";
+            }
+            else if(string_args == "match")
+            {
+                std::cout << "Command: match <engine> <engine> " <<
+                    "[games <n>] [concurrency <n>] [openings <epd file>] " <<
+                    "[depth <ply>] [nodes <n>] [movetime <ms>] " <<
+                    "[tc <s>+<s>] [hash <MB>] [maxply <ply>] " <<
+                    "[resign <cp> <moves>] [draw <cp> <moves> <ply>] " <<
+                    "[elo0 <elo>] [elo1 <elo>] [alpha <p>] [beta <p>] " <<
+                    "[sprt]" << std::endl;
+                std::cout << "Play games between two engines on a pool " <<
+                    "of threads and report the Elo difference and an " <<
+                    "SPRT verdict. An engine is either 'self', " <<
+                    "optionally followed by search parameters as in " <<
+                    "'self:null_reduction=3', or the path of a UCI " <<
+                    "engine. Every opening is played with both colours. " <<
+                    "With 'sprt', the match stops once the SPRT " <<
+                    "concludes. Plays at 10+0.1 if no budget is given. " <<
+                    "Adjudication move counts and plies can't exceed " <<
+                    "'maxply'.";
+            }
             else if(string_args == "cleartable")
             {
                 std::cout << "Command: cleartable" << std::endl;
@@ -296,7 +559,7 @@ int main()
         }
         else if(usr_cmd == "fen")
         {
-            std::getline(std::cin, string_args);
+            std::getline(input, string_args);
 
             unsigned int i = 1;
 
@@ -306,7 +569,7 @@ int main()
         }
         else if(usr_cmd == "searchd")
         {
-            std::cin >> string_args;
+            input >> string_args;
 
             if(!has_only_digits(string_args))
             {
@@ -320,6 +583,7 @@ int main()
             SearchInfo search_info;
             search_info.depth_set = 1;
             search_info.depth = argument;
+            search_info.interactive = 1; // Typing stops it.
 
             search_info.start_time = get_cur_time();
 
@@ -328,7 +592,7 @@ int main()
         }
         else if(usr_cmd == "searcht")
         {
-            std::cin >> string_args;
+            input >> string_args;
 
             if(!has_only_digits(string_args))
             {
@@ -343,6 +607,7 @@ int main()
             search_info.depth = MAX_DEPTH;
             search_info.time_set = 1;
             search_info.move_time = argument * 1000;
+            search_info.interactive = 1; // Typing stops it.
 
             search_info.start_time = get_cur_time();
 
@@ -377,7 +642,7 @@ int main()
         }
         else if(usr_cmd == "perft")
         {
-            std::cin >> string_args;
+            input >> string_args;
 
             if(!has_only_digits(string_args))
             {
@@ -397,7 +662,7 @@ int main()
         }
         else if(usr_cmd == "perftc")
         {
-            std::cin >> string_args;
+            input >> string_args;
 
             if(!has_only_digits(string_args))
             {
@@ -417,12 +682,10 @@ int main()
         }
         else if(usr_cmd == "testeval")
         {
-            std::string input;
-
-            std::ifstream test_suite;
-            test_suite.open("test_suites/strategic_test_suite.epd");
+            StrSlice input;
+            FenReader test_suite;
 
-            if(test_suite.is_open())
+            if(open_reader(test_suite, "test_suites/strategic_test_suite.epd"))
             {
                 Board temp_board;
 
@@ -430,7 +693,7 @@ int main()
                 unsigned int parse_errors = 0, eval_errors = 0;
                 unsigned int eval_orig, eval_flipped;
 
-                while(std::getline(test_suite, input))
+                while(next_line(test_suite, input))
                 {
                     i = 0;
 
@@ -457,7 +720,7 @@ int main()
                     " parse errors and " << eval_errors <<
                     " evaluation errors.";
 
-                test_suite.close();
+                close_reader(test_suite);
             }
             else
             {
@@ -466,6 +729,207 @@ int main()
 
             std::cout << std::endl << std::endl;
         }
+        else if(usr_cmd == "analyse")
+        {
+            AnalyseOptions options;
+            std::string epd_file;
+
+            std::getline(input, string_args);
+            std::stringstream args(string_args);
+
+            bool valid = parse_analyse_args(args, epd_file, options);
+
+            if(!valid)
+            {
+                std::cout << "ERROR: I did not understand the arguments. " <<
+                    "Please type 'helpc analyse' for help." << std::endl <<
+                    std::endl;
+                continue;
+            }
+
+            analyse_epd(epd_file, options);
+
+            std::cout << std::endl;
+        }
+        else if(usr_cmd == "gensfen")
+        {
+            SelfPlayOptions options;
+            std::string option;
+
+            options.threads = std::thread::hardware_concurrency();
+
+            std::getline(input, string_args);
+            std::stringstream args(string_args);
+
+            args >> options.out_file;
+
+            bool valid = !options.out_file.empty();
+            uint64 number;
+
+            while(valid && args >> option)
+            {
+                if(!(args >> string_args) ||
+                    !parse_uint(string_args, ~0ULL, number))
+                    valid = 0;
+                else if(option == "games") options.games = number;
+                else if(option == "depth" && number < MAX_DEPTH)
+                    options.depth = number;
+                else if(option == "nodes") options.nodes = number;
+                else if(option == "random" && number <= 0xffffffffULL)
+                    options.random_plies = number;
+                else if(option == "maxply" && number <= 0xffffffffULL)
+                    options.max_plies = number;
+                else if(option == "evallimit" && number <= INFINITY_C)
+                    options.eval_limit = number;
+                else if(option == "threads" && number >= 1 && number <= 1024)
+                    options.threads = number;
+                else if(option == "hash" && number >= 1 && number <= 32768)
+                    options.hash_size = number * 1048576;
+                else if(option == "seed") options.seed = number;
+                else valid = 0;
+            }
+
+            if(!valid)
+            {
+                std::cout << "ERROR: I did not understand the arguments. " <<
+                    "Please type 'helpc gensfen' for help." << std::endl <<
+                    std::endl;
+                continue;
+            }
+
+            gen_selfplay_data(options);
+
+            std::cout << std::endl;
+        }
+        else if(usr_cmd == "match")
+        {
+            MatchOptions options;
+            std::string option, value;
+            uint64 number;
+            double decimal, increment;
+
+            options.concurrency = std::thread::hardware_concurrency();
+
+            std::getline(input, string_args);
+            std::stringstream args(string_args);
+
+            args >> options.engines[0] >> options.engines[1];
+
+            bool valid = !options.engines[1].empty();
+
+            // Check the search parameters of internal engines up front, so
+            // a bad one is a usage error rather than a failed match.
+
+            for(unsigned int i = 0; i < 2; i++)
+            {
+                SearchParams params;
+
+                if(options.engines[i].compare(0, 5, "self:") == 0 &&
+                    !parse_search_params(options.engines[i].substr(5), params))
+                    valid = 0;
+            }
+
+            while(valid && args >> option)
+            {
+                if(option == "sprt")
+                {
+                    options.sprt_stop = 1;
+                    continue;
+                }
+
+                if(!(args >> value)) valid = 0;
+                else if(option == "openings") options.openings = value;
+                else if(option == "tc")
+                {
+                    std::size_t plus = value.find('+');
+                    std::string inc = (plus == std::string::npos) ?
+                        "0" : value.substr(plus + 1);
+
+                    value = value.substr(0, plus);
+                    valid = parse_decimal(value, 0, 1e6, decimal) &&
+                        parse_decimal(inc, 0, 1e6, increment);
+
+                    if(valid)
+                    {
+                        options.base_time = decimal * 1000;
+                        options.increment = increment * 1000;
+                    }
+                }
+                else if(option == "elo0" || option == "elo1")
+                {
+                    if(!parse_decimal(value, -1000, 1000, decimal)) valid = 0;
+                    else if(option == "elo0") options.elo0 = decimal;
+                    else options.elo1 = decimal;
+                }
+                else if(option == "alpha" || option == "beta")
+                {
+                    // Error rates must lie strictly between zero and one, or
+                    // the SPRT bounds are infinite or inverted.
+
+                    if(!parse_decimal(value, 0, 1, decimal) || decimal <= 0 ||
+                        decimal >= 1) valid = 0;
+                    else if(option == "alpha") options.alpha = decimal;
+                    else options.beta = decimal;
+                }
+                else if(!parse_uint(value, ~0ULL, number)) valid = 0;
+                else if(option == "games" && number <= 0xffffffffULL)
+                    options.games = number;
+                else if(option == "concurrency" && number >= 1 &&
+                    number <= 1024) options.concurrency = number;
+                else if(option == "depth" && number < MAX_DEPTH)
+                    options.depth = number;
+                else if(option == "nodes") options.nodes = number;
+                else if(option == "movetime") options.move_time = number;
+                else if(option == "hash" && number >= 1 && number <= 32768)
+                    options.hash_size = number * 1048576;
+                else if(option == "maxply" && number <= 0xffffffffULL)
+                    options.max_plies = number;
+                else if(option == "resign" && number <= INFINITY_C)
+                {
+                    options.resign_score = number;
+                    valid = (args >> value) &&
+                        parse_uint(value, 0xffffffffULL, number);
+
+                    if(valid) options.resign_moves = number;
+                }
+                else if(option == "draw" && number <= INFINITY_C)
+                {
+                    options.draw_score = number;
+                    valid = (args >> value) &&
+                        parse_uint(value, 0xffffffffULL, number);
+
+                    if(valid) options.draw_moves = number;
+
+                    valid = valid && (args >> value) &&
+                        parse_uint(value, 0xffffffffULL, number);
+
+                    if(valid) options.draw_start = number;
+                }
+                else valid = 0;
+            }
+
+            // Adjudication can't wait for longer than a game may last.
+
+            if(options.resign_moves > options.max_plies ||
+                options.draw_moves > options.max_plies ||
+                options.draw_start > options.max_plies) valid = 0;
+
+            // The SPRT needs its alternative hypothesis above the null one.
+
+            if(options.elo1 <= options.elo0) valid = 0;
+
+            if(!valid)
+            {
+                std::cout << "ERROR: I did not understand the arguments. " <<
+                    "Please type 'helpc match' for help." << std::endl <<
+                    std::endl;
+                continue;
+            }
+
+            play_match(options);
+
+            std::cout << std::endl;
+        }
         else if(usr_cmd == "cleartable")
         {
             clear_table(board.t_table);
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename defs.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.3
 
     @brief Holds definitions for code readability and speed improvements.
 
@@ -17,6 +17,9 @@
     * 06/12/2015 0.1.5 Added FLIPV[64] and FLIPV_BB.
     * 06/12/2015 0.1.6 Added pretty_bitboard(uint64).
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added StrSlice.
+    * 17/10/2026 1.0.2 Named the colour enumeration Color.
+    * 17/10/2026 1.0.3 Added parse_uint(const std::string&, uint64, uint64&).
 */
 
 /**
@@ -50,7 +53,7 @@ typedef unsigned long long uint64;
 
 // Enumerations
 
-enum { BLACK, WHITE };
+enum Color { BLACK, WHITE };
 
 enum { WKCA = 8, WQCA = 4, BKCA = 2, BQCA = 1 };
 
@@ -75,6 +78,42 @@ enum
     a8, b8, c8, d8, e8, f8, g8, h8, NO_SQ
 };
 
+// Structures
+
+/**
+    @struct StrSlice
+
+    @brief A read-only view into a run of characters owned by someone else,
+           such as a memory-mapped file or a std::string. Lets text be parsed
+           without copying it.
+
+    @var StrSlice::data
+         Pointer to the first character.
+    @var StrSlice::length
+         The number of characters in the slice.
+
+    @warning The slice is not null terminated, and is only valid as long as
+             the memory it points to is.
+*/
+
+struct StrSlice
+{
+    const char* data;
+    unsigned int length;
+
+    StrSlice()
+    :data(nullptr), length(0)
+    {}
+
+    StrSlice(const char* str, unsigned int len)
+    :data(str), length(len)
+    {}
+
+    StrSlice(const std::string& str)
+    :data(str.data()), length(str.length())
+    {}
+};
+
 // Globals
 
 const uint64 B_FILE[9] = {
@@ -307,4 +346,34 @@ inline std::string pretty_bitboard(uint64 bb)
     return pretty_str.str();
 }
 
+/**
+    @brief Parses a string of decimal digits into an integer no greater than
+           'max', without letting it overflow.
+
+    @param s is the string to parse.
+    @param max is the largest value to accept.
+    @param value is set to the parsed value on success.
+
+    @return bool denoting whether 's' held only digits, at least one, and
+            denoted a value no greater than 'max'.
+*/
+
+inline bool parse_uint(const std::string& s, uint64 max, uint64& value)
+{
+    if(s.empty() || s.find_first_not_of("0123456789") != std::string::npos)
+        return 0;
+
+    value = 0;
+
+    for(unsigned int i = 0; i < s.length(); i++)
+    {
+        unsigned int digit = s[i] - '0';
+
+        if(value > max / 10 || max - value * 10 < digit) return 0; // Too large.
+        value = value * 10 + digit;
+    }
+
+    return 1;
+}
+
 #endif // DEFS_H
\ No newline at end of file
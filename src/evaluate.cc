@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename evaluate.cc
     @author Anna Grygierzec
-    @version 1.0.0
+    @version 1.0.2
 
     @brief Static evaluation function that returns an objective score
            of the game state.
@@ -15,6 +15,8 @@
     * 22/12/2015 0.1.3 Added backward pawns, king on and near open file,
                        pawn shield, rook and bishop bonus for lost pawns.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added PIECE_VALUES.
+    * 17/10/2026 1.0.2 Pawn structure evaluated set-wise with Kogge-Stone fills, using AVX2 when available.
 */
 
 /**
@@ -33,6 +35,10 @@
 #include "movegen.h"
 #include "hash.h"
 
+#ifdef __AVX2__
+#include <immintrin.h> // AVX2 intrinsics.
+#endif
+
 // Globals
 
 // Piece values
@@ -49,6 +55,13 @@ const int S_KNIGHT_END = 250;
 const int S_BISHOP_END = 300;
 const int S_PAWN_END = 100;
 
+const int PIECE_VALUES[15] =
+{
+    S_PAWN, S_ROOK, S_KNIGHT, S_BISHOP, S_QUEEN, 0,
+    S_PAWN, S_ROOK, S_KNIGHT, S_BISHOP, S_QUEEN, 0,
+    0, 0, 0
+};
+
 // Global values
 
 // int S_MOBILITY = 10;
@@ -178,6 +191,9 @@ const int PAWN_ST[64] = {
 // Prototypes
 
 void init_evalmasks();
+inline void north_fill4(uint64 bb[4]);
+inline int pawn_structure(uint64 us, uint64 them, uint64 us_north,
+    uint64 us_south, uint64 them_south);
 int static_eval(Board& board);
 
 // Function definitions
@@ -265,6 +281,108 @@ void init_evalmasks()
     }
 }
 
+/**
+    @brief Fills four bitboards northwards with Kogge-Stone shifts, so that
+           every set bit is smeared up to the eighth rank.
+
+    When compiled with AVX2, the four fills run side by side in one 256-bit
+    register. Otherwise, a scalar loop does the same.
+
+    @param bb is an array of four bitboards, which are filled in place.
+
+    @return void.
+*/
+
+inline void north_fill4(uint64 bb[4])
+{
+#ifdef __AVX2__
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bb));
+
+    v = _mm256_or_si256(v, _mm256_slli_epi64(v, 8));
+    v = _mm256_or_si256(v, _mm256_slli_epi64(v, 16));
+    v = _mm256_or_si256(v, _mm256_slli_epi64(v, 32));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(bb), v);
+#else
+    for(unsigned int i = 0; i < 4; i++)
+    {
+        bb[i] |= bb[i] << 8;
+        bb[i] |= bb[i] << 16;
+        bb[i] |= bb[i] << 32;
+    }
+#endif
+}
+
+/**
+    @brief Scores isolated, doubled, passed and backward pawns of one side
+           set-wise, from white's side of the board.
+
+    The fills give each pawn's file, front span and rear span at once, and
+    shifting them a file to either side gives the attack spans, so that the
+    cost does not grow with the number of pawns.
+
+    @param us is the bitboard of the pawns to score.
+    @param them is the bitboard of the opposing pawns.
+    @param us_north is the north fill of 'us'.
+    @param us_south is the south fill of 'us'.
+    @param them_south is the south fill of 'them'.
+
+    @return int value denoting the pawn structure score of 'us'.
+
+    @warning Black's pawns must be flipped vertically, along with their
+             fills, before being scored.
+*/
+
+inline int pawn_structure(uint64 us, uint64 them, uint64 us_north,
+    uint64 us_south, uint64 them_south)
+{
+    const uint64 NOT_A = ~B_FILE[FILE_A];
+    const uint64 NOT_H = ~B_FILE[FILE_H];
+
+    // Isolated pawns have no pawns of their own on either adjacent file.
+
+    const uint64 files = us_north | us_south;
+    const uint64 isolated = us & ~(((files << 1) & NOT_A) |
+        ((files >> 1) & NOT_H));
+
+    // Doubled pawns have another pawn of their own on the same file.
+
+    const uint64 doubled = us & ((us_north << 8) | (us_south >> 8));
+
+    // Passed pawns have no opposing pawn ahead of them on the same or an
+    // adjacent file, that is, are outside the front and attack spans of the
+    // opposing pawns.
+
+    const uint64 span = them_south >> 8;
+    const uint64 attack_span = ((span << 1) & NOT_A) | ((span >> 1) & NOT_H);
+    const uint64 passed = us & ~(span | attack_span);
+
+    // Backward pawns have an opposing pawn ahead on an adjacent file. They
+    // are either isolated, or have a stop cell attacked by an opposing pawn
+    // with no pawn of their own beside or behind them on an adjacent file.
+    // On the second rank, the cell after the stop cell must be attacked too,
+    // and only a pawn beside them can help.
+
+    const uint64 support = ((us_north << 1) & NOT_A) |
+        ((us_north >> 1) & NOT_H);
+    const uint64 beside = ((us << 1) & NOT_A) | ((us >> 1) & NOT_H);
+    const uint64 attacks = ((them >> 7) & NOT_A) | ((them >> 9) & NOT_H);
+    const uint64 backward = us & attack_span & (isolated |
+        ((B_RANK[RANK_3] | B_RANK[RANK_4] | B_RANK[RANK_5]) & ~support &
+        (attacks >> 8)) |
+        (B_RANK[RANK_2] & ~beside & (attacks >> 8) & (attacks >> 16)));
+
+    int score = int(CNT_BITS(isolated)) * S_PAWN_ISOLATED +
+        int(CNT_BITS(doubled)) * S_PAWN_DOUBLED +
+        int(CNT_BITS(backward)) * S_PAWN_BACKWARD;
+
+    uint64 passers = passed;
+
+    while(passers) score += S_PAWN_PASSED[GET_RANK(POP_BIT(passers))];
+
+    return score;
+}
+
 /**
     @brief Performs a static evaluation of the given board state and deduces
            an objective integer score for it.
@@ -286,9 +404,8 @@ int static_eval(Board& board)
 
     uint64 pawns_bb = board.chessboard[wP] | board.chessboard[bP];
     int bishop_score, bishop_score_end, rook_score, rook_score_end;
-    unsigned int count, index, file, rank; // Temporary variables.
+    unsigned int count, index, file; // Temporary variables.
     uint64 piece_bb; // Temporary variable.
-    bool isolated;
 
     unsigned int white_mat = 0, black_mat = 0;
     unsigned int wq = 0, wr = 0, wn = 0, wb = 0, wp = 0,
@@ -399,6 +516,22 @@ int static_eval(Board& board)
         else if((wq + wr + wn + wb + bq + br + bb == 0) && bn <= 2) return 0;
     }
 
+    // Pawn structure of both sides. Black's pawns are flipped vertically, so
+    // that both sides are scored from white's side of the board, and all
+    // four fills needed run at once.
+
+    uint64 fills[4] = {board.chessboard[wP], board.chessboard[bP],
+        FLIPV_BB(board.chessboard[wP]), FLIPV_BB(board.chessboard[bP])};
+
+    north_fill4(fills);
+
+    const int white_pawns = pawn_structure(board.chessboard[wP],
+        board.chessboard[bP], fills[0], FLIPV_BB(fills[2]),
+        FLIPV_BB(fills[3]));
+    const int black_pawns = pawn_structure(FLIPV_BB(board.chessboard[bP]),
+        FLIPV_BB(board.chessboard[wP]), fills[3], FLIPV_BB(fills[1]),
+        FLIPV_BB(fills[0]));
+
     // Adjust scores as pawns as lost.
 
     bishop_score = S_BISHOP + (16 - wp - bp) * S_BISHOP_PAWNBONUS;
@@ -505,51 +638,11 @@ int static_eval(Board& board)
         piece_bb = board.chessboard[wP];
         count = wp;
         score += count * S_PAWN; // Material score
-
+        score += white_pawns; // Pawn structure
 
         for(unsigned int i = 0; i < count; i++)
         {
             index = POP_BIT(piece_bb);
-            file = GET_FILE(index);
-            rank = GET_RANK(index);
-
-            // Isolated
-
-            isolated = ((board.chessboard[wP] & PAWN_ISO_MASK[index]) == 0ULL);
-
-            if(isolated) score += S_PAWN_ISOLATED;
-
-            uint64 pawn_on_file = (board.chessboard[wP] & B_FILE[file]) ^
-                GET_BB(index);
-
-            // Doubled
-
-            if(pawn_on_file) score += S_PAWN_DOUBLED;
-
-            // Passed or backward
-
-            if((board.chessboard[bP] & PAWN_WPAS_MASK[index]) == 0ULL)
-                score += S_PAWN_PASSED[rank];
-            else if(board.chessboard[bP] & PAWN_ISO_MASK[index] & PAWN_WPAS_MASK[index])
-            {
-                if(isolated)
-                    score += S_PAWN_BACKWARD;
-                else if((index > 15) && (index < 40) &&
-                    ((board.chessboard[wP] & PAWN_ISO_MASK[index] &
-                    PAWN_BPAS_MASK[index + 8]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index + 16] & board.chessboard[bP]))
-                {
-                    score += S_PAWN_BACKWARD;
-                }
-                else if((index < 16) &&
-                    ((PAWN_NEXT_MASK[index] & board.chessboard[wP]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index + 16] & board.chessboard[bP]) &&
-                    (PAWN_NEXT_MASK[index + 24] & board.chessboard[bP]))
-                {
-                    score += S_PAWN_BACKWARD;
-                }
-            }
-
             score += PAWN_ST[index]; // Piece-square table
 
              // Pawn shield
@@ -641,50 +734,11 @@ int static_eval(Board& board)
         piece_bb = board.chessboard[wP];
         count = wp;
         score += count * S_PAWN_END; // Material score
+        score += white_pawns; // Pawn structure
 
         for(unsigned int i = 0; i < count; i++)
         {
             index = POP_BIT(piece_bb);
-            file = GET_FILE(index);
-            rank = GET_RANK(index);
-
-            // Isolated
-
-            isolated = ((board.chessboard[wP] & PAWN_ISO_MASK[index]) == 0ULL);
-
-            if(isolated) score += S_PAWN_ISOLATED;
-
-            uint64 pawn_on_file = (board.chessboard[wP] & B_FILE[file]) ^
-                GET_BB(index);
-
-            // Doubled
-
-            if(pawn_on_file) score += S_PAWN_DOUBLED;
-
-            // Passed or backward
-
-            if((board.chessboard[bP] & PAWN_WPAS_MASK[index]) == 0ULL)
-                score += S_PAWN_PASSED[rank];
-            else if(board.chessboard[bP] & PAWN_ISO_MASK[index] & PAWN_WPAS_MASK[index])
-            {
-                if(isolated)
-                    score += S_PAWN_BACKWARD;
-                else if((index > 15) && (index < 40) &&
-                    ((board.chessboard[wP] & PAWN_ISO_MASK[index] &
-                    PAWN_BPAS_MASK[index + 8]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index + 16] & board.chessboard[bP]))
-                {
-                    score += S_PAWN_BACKWARD;
-                }
-                else if((index < 16) &&
-                    ((PAWN_NEXT_MASK[index] & board.chessboard[wP]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index + 16] & board.chessboard[bP]) &&
-                    (PAWN_NEXT_MASK[index + 24] & board.chessboard[bP]))
-                {
-                    score += S_PAWN_BACKWARD;
-                }
-            }
-
             score += PAWN_ST[index]; // Piece-square table
         }
     }
@@ -788,50 +842,11 @@ int static_eval(Board& board)
         piece_bb = board.chessboard[bP];
         count = bp;
         score -= count * S_PAWN; // Material score
+        score -= black_pawns; // Pawn structure
 
         for(unsigned int i = 0; i < count; i++)
         {
             index = POP_BIT(piece_bb);
-            file = GET_FILE(index);
-            rank = GET_RANK(index);
-
-            // Isolated
-
-            isolated = ((board.chessboard[bP] & PAWN_ISO_MASK[index]) == 0ULL);
-
-            if(isolated) score -= S_PAWN_ISOLATED;
-
-            uint64 pawn_on_file = (board.chessboard[bP] & B_FILE[file]) ^
-                GET_BB(index);
-
-            // Doubled
-
-            if(pawn_on_file) score -= S_PAWN_DOUBLED;
-
-            // Passed or backward
-
-            if((board.chessboard[wP] & PAWN_BPAS_MASK[index]) == 0ULL)
-                score -= S_PAWN_PASSED[9 - rank];
-            else if(board.chessboard[wP] & PAWN_ISO_MASK[index] & PAWN_BPAS_MASK[index])
-            {
-                if(isolated)
-                    score -= S_PAWN_BACKWARD;
-                else if((index > 15) && (index < 48) &&
-                    ((board.chessboard[bP] & PAWN_ISO_MASK[index] &
-                    PAWN_WPAS_MASK[index - 8]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index - 16] & board.chessboard[wP]))
-                {
-                    score -= S_PAWN_BACKWARD;
-                }
-                else if((index > 47) &&
-                    ((PAWN_NEXT_MASK[index] & board.chessboard[bP]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index - 16] & board.chessboard[wP]) &&
-                    (PAWN_NEXT_MASK[index - 24] & board.chessboard[wP]))
-                {
-                    score -= S_PAWN_BACKWARD;
-                }
-            }
-
             score -= PAWN_ST[FLIPV[index]]; // Piece-square table
 
             // Pawn shield
@@ -922,50 +937,11 @@ int static_eval(Board& board)
         piece_bb = board.chessboard[bP];
         count = bp;
         score -= count * S_PAWN_END; // Material score
+        score -= black_pawns; // Pawn structure
 
         for(unsigned int i = 0; i < count; i++)
         {
             index = POP_BIT(piece_bb);
-            file = GET_FILE(index);
-            rank = GET_RANK(index);
-
-            // Isolated
-
-            isolated = ((board.chessboard[bP] & PAWN_ISO_MASK[index]) == 0ULL);
-
-            if(isolated) score -= S_PAWN_ISOLATED;
-
-            uint64 pawn_on_file = (board.chessboard[bP] & B_FILE[file]) ^
-                GET_BB(index);
-
-            // Doubled
-
-            if(pawn_on_file) score -= S_PAWN_DOUBLED;
-
-            // Passed or backward
-
-            if((board.chessboard[wP] & PAWN_BPAS_MASK[index]) == 0ULL)
-                score -= S_PAWN_PASSED[9 - rank];
-            else if(board.chessboard[wP] & PAWN_ISO_MASK[index] & PAWN_BPAS_MASK[index])
-            {
-                if(isolated)
-                    score -= S_PAWN_BACKWARD;
-                else if((index > 15) && (index < 48) &&
-                    ((board.chessboard[bP] & PAWN_ISO_MASK[index] &
-                    PAWN_WPAS_MASK[index - 8]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index - 16] & board.chessboard[wP]))
-                {
-                    score -= S_PAWN_BACKWARD;
-                }
-                else if((index > 47) &&
-                    ((PAWN_NEXT_MASK[index] & board.chessboard[bP]) == 0ULL) &&
-                    (PAWN_NEXT_MASK[index - 16] & board.chessboard[wP]) &&
-                    (PAWN_NEXT_MASK[index - 24] & board.chessboard[wP]))
-                {
-                    score -= S_PAWN_BACKWARD;
-                }
-            }
-
             score -= PAWN_ST[FLIPV[index]]; // Piece-square table
         }
     }
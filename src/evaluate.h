@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename evaluate.h
     @author Anna Grygierzec
-    @version 1.0.0
+    @version 1.0.1
 
     @brief Static evaluation function that returns an objective score
            of the game state.
@@ -15,6 +15,7 @@
     * 22/12/2015 0.1.3 Added backward pawns, king on and near open file,
                        pawn shield, rook and bishop bonus for lost pawns.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added PIECE_VALUES.
 */
 
 /**
@@ -33,6 +34,13 @@
 
 #include "board.h"
 
+// Globals
+
+// Middlegame value of each piece type in standard convention, zero for kings
+// and the empty square.
+
+extern const int PIECE_VALUES[15];
+
 // External function declarations
 
 extern void init_evalmasks(); // Initialise all bitmasks.
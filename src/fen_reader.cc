@@ -0,0 +1,231 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename fen_reader.cc
+    @author Shreyas Vinod
+    @version 0.1.0
+
+    @brief Reads FEN and EPD files through a memory mapping.
+
+    Maps a whole position file into memory and hands out its lines as
+    slices, so that positions can be parsed in place without copying or
+    allocating per line. Suitable for very large position dumps.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+*/
+
+/**
+    @file
+    @filename fen_reader.cc
+    @author Shreyas Vinod
+
+    @brief Reads FEN and EPD files through a memory mapping.
+
+    Maps a whole position file into memory and hands out its lines as
+    slices, so that positions can be parsed in place without copying or
+    allocating per line. Suitable for very large position dumps.
+*/
+
+#include "defs.h"
+
+#include <string> // std::string
+#include <cstring> // memchr()
+#include <cctype> // isspace()
+#include <fcntl.h> // open()
+#include <unistd.h> // close()
+#include <sys/mman.h> // mmap(), munmap() and madvise()
+#include <sys/stat.h> // fstat()
+
+#include "fen_reader.h"
+
+// Prototypes
+
+bool open_reader(FenReader& reader, const std::string& path);
+void close_reader(FenReader& reader);
+bool next_line(FenReader& reader, StrSlice& line);
+StrSlice epd_operations(const StrSlice& line);
+bool find_opcode(const StrSlice& operations, const std::string& opcode,
+    StrSlice& operands);
+
+// Function definitions
+
+/**
+    @brief Maps a position file into memory for reading.
+
+    @param reader is the reader to open.
+    @param path is the path of the file to map.
+
+    @return bool denoting whether the file could be mapped.
+
+    @warning Any file previously opened with 'reader' is closed.
+    @warning An empty file is opened successfully, but has no lines.
+*/
+
+bool open_reader(FenReader& reader, const std::string& path)
+{
+    close_reader(reader);
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return 0;
+
+    struct stat info;
+
+    if(fstat(fd, &info) < 0 || !S_ISREG(info.st_mode))
+    {
+        close(fd);
+        return 0;
+    }
+
+    if(info.st_size == 0) // Nothing to map.
+    {
+        close(fd);
+        return 1;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping outlives the descriptor.
+
+    if(data == MAP_FAILED) return 0;
+
+    madvise(data, info.st_size, MADV_SEQUENTIAL); // Only a hint.
+
+    reader.data = static_cast<const char*>(data);
+    reader.size = info.st_size;
+
+    return 1;
+}
+
+/**
+    @brief Unmaps the file held by a reader and resets it.
+
+    @param reader is the reader to close.
+
+    @return void.
+*/
+
+void close_reader(FenReader& reader)
+{
+    if(reader.data) munmap(const_cast<char*>(reader.data), reader.size);
+
+    reader.data = nullptr;
+    reader.size = 0;
+    reader.offset = 0;
+    reader.line = 0;
+}
+
+/**
+    @brief Reads the next line of the file, without copying it.
+
+    @param reader is the reader to read from.
+    @param line is the slice to point at the line, excluding the line
+           terminator ('\n' or "\r\n").
+
+    @return bool denoting whether a line was read, that is, whether the end
+            of the file hadn't already been reached.
+*/
+
+bool next_line(FenReader& reader, StrSlice& line)
+{
+    if(reader.offset >= reader.size) return 0;
+
+    const char* start = reader.data + reader.offset;
+    uint64 remaining = reader.size - reader.offset;
+    const char* end = static_cast<const char*>(memchr(start, '\n', remaining));
+    uint64 length = end ? uint64(end - start) : remaining;
+
+    reader.offset += end ? length + 1 : length;
+    reader.line++;
+
+    if(length && start[length - 1] == '\r') length--;
+
+    line = StrSlice(start, length);
+
+    return 1;
+}
+
+/**
+    @brief Returns the operations of an EPD line, that is, everything after
+           the four FEN fields it opens with.
+
+    @param line is the EPD line.
+
+    @return StrSlice holding the operations, which is empty if there are
+            none or the line has fewer than four fields.
+*/
+
+StrSlice epd_operations(const StrSlice& line)
+{
+    unsigned int i = 0;
+
+    for(unsigned int fields = 0; fields < 4; fields++)
+    {
+        while(i < line.length && isspace(line.data[i])) i++;
+        while(i < line.length && !isspace(line.data[i])) i++;
+    }
+
+    while(i < line.length && isspace(line.data[i])) i++;
+
+    return StrSlice(line.data + i, line.length - i);
+}
+
+/**
+    @brief Finds the operands of an EPD opcode, such as 'bm' or 'id'.
+
+    @param operations is the operations part of an EPD line.
+    @param opcode is the opcode to look for.
+    @param operands is the slice to point at the operands of the opcode,
+           excluding the terminating semicolon and surrounding whitespace.
+
+    @return bool denoting whether the opcode was found.
+
+    @warning Quotes are left on string operands.
+*/
+
+bool find_opcode(const StrSlice& operations, const std::string& opcode,
+    StrSlice& operands)
+{
+    unsigned int i = 0, start, end;
+    bool quoted;
+
+    while(i < operations.length)
+    {
+        while(i < operations.length && isspace(operations.data[i])) i++;
+
+        // Opcode
+
+        start = i;
+
+        while(i < operations.length && !isspace(operations.data[i]) &&
+            operations.data[i] != ';') i++;
+
+        bool match = (i - start == opcode.length()) &&
+            !opcode.compare(0, opcode.length(), operations.data + start,
+            i - start);
+
+        // Operands, up to the first semicolon outside of quotes.
+
+        while(i < operations.length && isspace(operations.data[i])) i++;
+
+        start = i;
+        quoted = 0;
+
+        while(i < operations.length && (quoted || operations.data[i] != ';'))
+        {
+            if(operations.data[i] == '"') quoted = !quoted;
+            i++;
+        }
+
+        end = i++;
+
+        if(!match) continue;
+
+        while(end > start && isspace(operations.data[end - 1])) end--;
+
+        operands = StrSlice(operations.data + start, end - start);
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename fen_reader.h
+    @author Shreyas Vinod
+    @version 0.1.0
+
+    @brief Reads FEN and EPD files through a memory mapping.
+
+    Maps a whole position file into memory and hands out its lines as
+    slices, so that positions can be parsed in place without copying or
+    allocating per line. Suitable for very large position dumps.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+*/
+
+/**
+    @file
+    @filename fen_reader.h
+    @author Shreyas Vinod
+
+    @brief Reads FEN and EPD files through a memory mapping.
+
+    Maps a whole position file into memory and hands out its lines as
+    slices, so that positions can be parsed in place without copying or
+    allocating per line. Suitable for very large position dumps.
+*/
+
+#ifndef FEN_READER_H
+#define FEN_READER_H
+
+#include "defs.h"
+
+#include <string> // std::string
+
+// Structures
+
+/**
+    @struct FenReader
+
+    @brief Holds a memory-mapped position file and the position of the
+           reader within it.
+
+    @var FenReader::data
+         The mapped contents of the file.
+    @var FenReader::size
+         The size of the file in bytes.
+    @var FenReader::offset
+         The offset of the next line to be read.
+    @var FenReader::line
+         The line number of the last line read, starting from one.
+
+    @warning Slices handed out by the reader are only valid until the reader
+             is closed.
+*/
+
+struct FenReader
+{
+    const char* data;
+    uint64 size;
+    uint64 offset;
+    unsigned int line;
+
+    FenReader()
+    :data(nullptr), size(0), offset(0), line(0)
+    {}
+};
+
+// External function declarations
+
+// Map a position file into memory.
+
+extern bool open_reader(FenReader& reader, const std::string& path);
+
+extern void close_reader(FenReader& reader); // Unmap the file.
+
+// Read the next line of the file as a slice.
+
+extern bool next_line(FenReader& reader, StrSlice& line);
+
+// Return the operations of an EPD line, following the four FEN fields.
+
+extern StrSlice epd_operations(const StrSlice& line);
+
+// Find the operands of an EPD opcode.
+
+extern bool find_opcode(const StrSlice& operations, const std::string& opcode,
+    StrSlice& operands);
+
+#endif // FEN_READER_H
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename hash.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.2
 
     @brief Handles zobrist hashing to generate hashes for game states.
 
@@ -16,6 +16,8 @@
         * Added HASH_PIECE(Board&, unsigned int, unsigned int),
           HASH_SIDE(Board&), HASH_CA(Board&) and HASH_EP(Board&).
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added EXCLUSION_KEY.
+    * 17/10/2026 1.0.2 Added cuckoo tables of the hash key changes of reversible moves.
 */
 
 /**
@@ -35,10 +37,13 @@
 
 #include "hash.h"
 #include "board.h"
+#include "move.h" // GET_MOVE()
+#include "lookup_tables.h"
 
 // Prototypes
 
 void init_hash();
+void init_cuckoo();
 uint64 gen_hash(const Board& board);
 
 // Globals
@@ -46,6 +51,9 @@ uint64 gen_hash(const Board& board);
 uint64 PIECE_KEYS[13][64]; // 64 keys for each piece; 64 for en passant.
 uint64 SIDE_KEY; // Hashed in if side to play is white.
 uint64 CASTLE_KEYS[16]; // 16 keys for castling permissions.
+uint64 EXCLUSION_KEY; // Multiplied by an excluded move; always odd.
+uint64 CUCKOO_KEYS[CUCKOO_SIZE]; // Key changes of reversible moves.
+unsigned int CUCKOO_MOVES[CUCKOO_SIZE]; // The moves for 'CUCKOO_KEYS'.
 
 // Function definitions
 
@@ -82,6 +90,83 @@ void init_hash()
     {
         CASTLE_KEYS[i] = gen_rand();
     }
+
+    // Odd, so that distinct moves give distinct products.
+
+    EXCLUSION_KEY = gen_rand() | 1ULL;
+
+    init_cuckoo();
+}
+
+/**
+    @brief Initialises the cuckoo tables with the hash key change of every
+           reversible move, that is, every move of a piece other than a pawn
+           between two cells on an empty board.
+
+    Each key is stored in one of two slots given by CUCKOO_H1() and
+    CUCKOO_H2(), evicting whatever was there to its other slot in turn.
+
+    @return void.
+
+    @warning Called by init_hash(), once the keys have been initialised.
+*/
+
+void init_cuckoo()
+{
+    const uint64* attacks = nullptr;
+    unsigned int count = 0, index, move, temp_move;
+    uint64 key, temp_key;
+
+    for(unsigned int i = 0; i < CUCKOO_SIZE; i++)
+    {
+        CUCKOO_KEYS[i] = 0ULL;
+        CUCKOO_MOVES[i] = NO_MOVE;
+    }
+
+    for(unsigned int piece = wR; piece <= bK; piece++)
+    {
+        switch(piece)
+        {
+            case wR: case bR: attacks = LINE_LT; break;
+            case wN: case bN: attacks = KNIGHT_LT; break;
+            case wB: case bB: attacks = DIAG_LT; break;
+            case wQ: case bQ: attacks = LINE_DIAG_LT; break;
+            case wK: case bK: attacks = KING_LT; break;
+            default: continue; // Pawn moves are irreversible.
+        }
+
+        for(unsigned int from = 0; from < 64; from++)
+        {
+            for(unsigned int to = from + 1; to < 64; to++)
+            {
+                if(!(attacks[from] & GET_BB(to))) continue;
+
+                move = GET_MOVE(from, to, EMPTY, EMPTY, 0);
+                key = PIECE_KEYS[piece][from] ^ PIECE_KEYS[piece][to] ^
+                    SIDE_KEY;
+                index = CUCKOO_H1(key);
+
+                while(1) // Insert, evicting entries until a slot is free.
+                {
+                    temp_key = CUCKOO_KEYS[index];
+                    temp_move = CUCKOO_MOVES[index];
+                    CUCKOO_KEYS[index] = key;
+                    CUCKOO_MOVES[index] = move;
+                    key = temp_key;
+                    move = temp_move;
+
+                    if(move == NO_MOVE) break;
+
+                    index = (index == CUCKOO_H1(key)) ? CUCKOO_H2(key) :
+                        CUCKOO_H1(key);
+                }
+
+                count++;
+            }
+        }
+    }
+
+    assert(count == 3668);
 }
 
 /**
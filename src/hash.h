@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename hash.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.2
 
     @brief Handles zobrist hashing to generate hashes for game states.
 
@@ -16,6 +16,8 @@
         * Added HASH_PIECE(Board&, unsigned int, unsigned int),
           HASH_SIDE(Board&), HASH_CA(Board&) and HASH_EP(Board&).
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added EXCLUSION_KEY and EXCLUDED_HASH().
+    * 17/10/2026 1.0.2 Added the cuckoo tables, CUCKOO_H1() and CUCKOO_H2().
 */
 
 /**
@@ -36,11 +38,18 @@
 
 #include "board.h"
 
+// Macros
+
+#define CUCKOO_SIZE 8192 // Size of the cuckoo tables.
+
 // Globals
 
 extern uint64 PIECE_KEYS[13][64]; // 64 keys for each piece; 64 for en passant.
 extern uint64 SIDE_KEY; // Hashed in if side to play is white.
 extern uint64 CASTLE_KEYS[16]; // 16 keys for castling permissions.
+extern uint64 EXCLUSION_KEY; // Multiplied by an excluded move; always odd.
+extern uint64 CUCKOO_KEYS[CUCKOO_SIZE]; // Key changes of reversible moves.
+extern unsigned int CUCKOO_MOVES[CUCKOO_SIZE]; // The moves for 'CUCKOO_KEYS'.
 
 // Helper functions for hashing
 
@@ -124,6 +133,50 @@ inline void HASH_EP(Board& board)
     }
 }
 
+/**
+    @brief Derives the hash key of a position searched with a move excluded,
+           so that such searches have transposition table entries of their
+           own.
+
+    @param hash_key is the zobrist hash of the board.
+    @param move is the excluded move.
+
+    @return uint64 value denoting the hash key to use in the table.
+
+    @warning 'move' must not be 'NO_MOVE', which would leave the key as is.
+*/
+
+inline uint64 EXCLUDED_HASH(uint64 hash_key, unsigned int move)
+{
+    return hash_key ^ (EXCLUSION_KEY * move);
+}
+
+/**
+    @brief The first of the two cuckoo table slots a key may be stored in.
+
+    @param key is the hash key change of a move.
+
+    @return unsigned int index into the cuckoo tables.
+*/
+
+inline unsigned int CUCKOO_H1(uint64 key)
+{
+    return key & (CUCKOO_SIZE - 1);
+}
+
+/**
+    @brief The second of the two cuckoo table slots a key may be stored in.
+
+    @param key is the hash key change of a move.
+
+    @return unsigned int index into the cuckoo tables.
+*/
+
+inline unsigned int CUCKOO_H2(uint64 key)
+{
+    return (key >> 16) & (CUCKOO_SIZE - 1);
+}
+
 // External function declarations
 
 extern void init_hash(); // Initialise keys.
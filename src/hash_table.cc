@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename hash_table.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.11
 
     @brief Handles hash tables for efficient move searching.
 
@@ -14,6 +14,19 @@
     * 28/11/2015 0.1.0 Initial version.
     * 03/12/2015 0.1.1 Updated to a full transposition table.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Tables are now freed with delete[] and reset after freeing.
+    * 17/10/2026 1.0.2 init_table() takes a 64-bit size.
+    * 17/10/2026 1.0.3 Added hash_full().
+    * 17/10/2026 1.0.4 Added probe_entry().
+    * 17/10/2026 1.0.5 probe_table() no longer falls through from a bound that does not cut to a hit.
+        * Quiescence entries no longer replace main search entries.
+    * 17/10/2026 1.0.6 probe_table() returns the stored score on a cutoff, for a fail-soft search.
+    * 17/10/2026 1.0.7 Entries are stored in a lockless format, with the key XORed with the packed data.
+        * Added init_shared_table(), to attach to a table in a named POSIX shared memory segment.
+    * 17/10/2026 1.0.8 init_table() returns whether the allocation succeeded, keeping the previous table if not.
+    * 17/10/2026 1.0.9 Quiescence entries only give way to main search entries for the same position.
+    * 17/10/2026 1.0.10 init_shared_table() refuses segments that don't hold a whole number of entries, or none.
+    * 17/10/2026 1.0.11 init_shared_table() creates segments exclusively, so two processes can't size one differently.
 */
 
 /**
@@ -29,15 +42,27 @@
 
 #include "defs.h"
 
-#include <new> // ::operator new
+#include <new> // ::operator new, std::nothrow
+#include <string> // std::string
 #include <assert.h> // std::assert()
+#include <sys/mman.h> // shm_open(), mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <fcntl.h> // O_CREAT, O_EXCL, O_RDWR
+#include <unistd.h> // ftruncate(), close(), usleep()
+#include <errno.h> // errno, EEXIST
 
 #include "hash_table.h"
 #include "movegen.h"
 
 // Prototypes
 
-void init_table(TranspositionTable& t_table, unsigned int t_size);
+inline uint64 pack_entry(unsigned int move, int score, unsigned int depth,
+    unsigned int flag);
+inline bool read_entry(const TranspositionTable& t_table, uint64 hash_key,
+    TableEntry& entry);
+bool init_table(TranspositionTable& t_table, uint64 t_size);
+bool init_shared_table(TranspositionTable& t_table, uint64 t_size,
+    const std::string& name);
 void free_table(TranspositionTable& t_table);
 void clear_table(TranspositionTable& t_table);
 void store_entry(TranspositionTable& t_table, unsigned int ply,
@@ -47,27 +72,195 @@ bool probe_table(TranspositionTable& t_table, unsigned int ply,
     uint64 hash_key, unsigned int depth, unsigned int& pv_move, int& score,
     int alpha, int beta);
 unsigned int probe_pv_table(TranspositionTable& t_table, uint64 hash_key);
+bool probe_entry(const TranspositionTable& t_table, unsigned int ply,
+    uint64 hash_key, TableEntry& entry);
+unsigned int hash_full(const TranspositionTable& t_table);
 
 // Function definitions
 
+/**
+    @brief Packs the contents of an entry into one 64-bit word, as laid out
+           in PackedEntry::data.
+
+    @param move is the move to pack, of at most 23 bits.
+    @param score is the score to pack.
+    @param depth is the depth to pack, below 128.
+    @param flag is the flag to pack; TFALPHA, TFBETA or TFEXACT.
+
+    @return uint64 holding the packed entry.
+*/
+
+inline uint64 pack_entry(unsigned int move, int score, unsigned int depth,
+    unsigned int flag)
+{
+    assert(move < (1U << 23) && depth < 128 && flag < 4);
+
+    return uint64(move) | (uint64(flag) << 23) | (uint64(depth) << 25) |
+        (uint64(static_cast<unsigned int>(score)) << 32);
+}
+
+/**
+    @brief Reads and unpacks the entry for the given hash key, if the table
+           holds one.
+
+    The entry's words are read once each, and the key is checked against
+    both, so that an entry being written by another search is never mixed
+    up with the one before it.
+
+    @param t_table is the hash table to read from.
+    @param hash_key is the zobrist hash of the board to index the table with.
+    @param entry is the entry to unpack into.
+
+    @return bool denoting whether an entry for the hash key was found.
+*/
+
+inline bool read_entry(const TranspositionTable& t_table, uint64 hash_key,
+    TableEntry& entry)
+{
+    unsigned int index = hash_key % t_table.num_entries;
+
+    assert(index < t_table.num_entries);
+
+    const uint64 data = t_table.t_entry[index].data;
+    const uint64 key = t_table.t_entry[index].key;
+
+    if((key ^ data) != hash_key) return 0;
+
+    entry.hash_key = hash_key;
+    entry.move = data & 0x7fffff;
+    entry.flag = (data >> 23) & 0x3;
+    entry.depth = (data >> 25) & 0x7f;
+    entry.score = static_cast<int>(static_cast<unsigned int>(data >> 32));
+
+    return 1;
+}
+
 /**
     @brief Initialises memory for a transposition table. Everything is zeroed.
 
     @param t_table is the hash table to initialise.
     @param t_size is the size in bytes of the hash table to be initialised.
 
-    @return void.
+    @return bool denoting whether the memory could be allocated. If not, the
+            table is left as it was.
 */
 
-void init_table(TranspositionTable& t_table, unsigned int t_size)
+bool init_table(TranspositionTable& t_table, uint64 t_size)
 {
-    t_table.num_entries = t_size / sizeof(TableEntry);
-    if(t_table.t_entry) delete t_table.t_entry;
-    t_table.t_entry = new TableEntry[t_table.num_entries];
+    unsigned int num_entries = t_size / sizeof(PackedEntry);
+    PackedEntry* t_entry = new (std::nothrow) PackedEntry[num_entries];
+
+    if(!t_entry) return 0;
+
+    free_table(t_table);
+
+    t_table.t_entry = t_entry;
+    t_table.num_entries = num_entries;
+
+    return 1;
 }
 
 /**
-    @brief Frees table memory.
+    @brief Attaches a transposition table to the named POSIX shared memory
+           segment, creating the segment if it doesn't exist yet, so that
+           several processes may search with one table.
+
+    A new segment is created exclusively, so only one process ever sizes
+    it, to 't_size' rounded down to a whole number of entries, and zeroed.
+    An existing segment keeps the size it was created with, whatever
+    't_size' is, but is refused unless it holds a whole number of entries,
+    and at least one. If its creator hasn't sized it yet, this waits up to
+    a second for it to.
+
+    @param t_table is the hash table to initialise.
+    @param t_size is the size in bytes of a new segment.
+    @param name is the name of the segment, such as '/cortex'. A leading
+           slash is added if it's missing.
+
+    @return bool denoting whether the table was attached. If not, the table
+            is left empty.
+
+    @warning 'name' mustn't be empty.
+
+    @warning The segment outlives the processes using it, until it's removed
+             by hand (from /dev/shm on Linux).
+*/
+
+bool init_shared_table(TranspositionTable& t_table, uint64 t_size,
+    const std::string& name)
+{
+    free_table(t_table);
+
+    // Portable names have a single leading slash.
+
+    std::string path = (name[0] == '/') ? name : "/" + name;
+
+    bool created = 1;
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if(fd < 0 && errno == EEXIST) // Attach to the existing segment.
+    {
+        created = 0;
+        fd = shm_open(path.c_str(), O_RDWR, 0600);
+    }
+
+    if(fd < 0) return 0;
+
+    // A new segment holds a whole number of entries. An existing one must
+    // hold at least one, and a whole number of them, to be indexed safely.
+
+    struct stat st;
+    uint64 size = t_size - t_size % sizeof(PackedEntry);
+
+    if(created)
+    {
+        // Other processes map the size they find, so it must be the size
+        // that was asked for.
+
+        if(!size || ftruncate(fd, off_t(size)) != 0 || fstat(fd, &st) != 0 ||
+            uint64(st.st_size) != size)
+        {
+            shm_unlink(path.c_str()); // Don't leave a segment nobody can use.
+            size = 0;
+        }
+    }
+    else
+    {
+        // The creator may not have sized the segment yet.
+
+        for(unsigned int tries = 0; ; tries++)
+        {
+            if(fstat(fd, &st) != 0) size = 0;
+            else size = uint64(st.st_size);
+
+            if(size || tries == 100) break;
+
+            usleep(10000);
+        }
+    }
+
+    if(size < sizeof(PackedEntry) || size % sizeof(PackedEntry) != 0 ||
+        size / sizeof(PackedEntry) > 0xffffffffULL)
+    {
+        close(fd);
+        return 0;
+    }
+
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    close(fd); // The mapping holds its own reference.
+
+    if(map == MAP_FAILED) return 0;
+
+    t_table.t_entry = static_cast<PackedEntry*>(map);
+    t_table.num_entries = size / sizeof(PackedEntry);
+    t_table.map_size = size;
+
+    return 1;
+}
+
+/**
+    @brief Frees table memory, or detaches from a shared table.
 
     @param t_table is the hash table to free.
 
@@ -76,24 +269,32 @@ void init_table(TranspositionTable& t_table, unsigned int t_size)
 
 void free_table(TranspositionTable& t_table)
 {
-    if(t_table.t_entry) delete t_table.t_entry;
+    if(t_table.map_size) munmap(t_table.t_entry, t_table.map_size);
+    else if(t_table.t_entry) delete[] t_table.t_entry;
+
+    t_table.t_entry = nullptr;
+    t_table.num_entries = 0;
+    t_table.map_size = 0ULL;
 }
 
 /**
     @brief Clears the given table by zeroing everything out.
 
     @param t_table is the hash table to clear.
+
+    @warning Shared tables are left as they are, since other processes may
+             be searching with them. Nothing reports this, so callers facing
+             a user, such as the UCI 'Clear Hash' button, should say so.
 */
 
 void clear_table(TranspositionTable& t_table)
 {
+    if(t_table.map_size) return;
+
     for(unsigned int i = 0; i < t_table.num_entries; i++)
     {
-        t_table.t_entry[i].hash_key = 0ULL;
-        t_table.t_entry[i].move = NO_MOVE;
-        t_table.t_entry[i].score = 0;
-        t_table.t_entry[i].depth = 0;
-        t_table.t_entry[i].flag = 0;
+        t_table.t_entry[i].key = 0ULL;
+        t_table.t_entry[i].data = 0ULL;
     }
 }
 
@@ -109,6 +310,10 @@ void clear_table(TranspositionTable& t_table)
     @param flag represents the set flag.
 
     @return void.
+
+    @warning An entry of depth zero, from quiescence search, doesn't replace
+             a main search entry for the same position. Entries for other
+             positions are always replaced.
 */
 
 void store_entry(TranspositionTable& t_table, unsigned int ply,
@@ -119,14 +324,21 @@ void store_entry(TranspositionTable& t_table, unsigned int ply,
 
     assert(index < t_table.num_entries);
 
+    // Quiescence entries never replace main search entries for the same
+    // position.
+
+    TableEntry entry;
+
+    if(depth == 0 && read_entry(t_table, hash_key, entry) && entry.depth > 0)
+        return;
+
     if(score > IS_MATE) score += ply;
     else if(score < -IS_MATE) score -= ply;
 
-    t_table.t_entry[index].hash_key = hash_key;
-    t_table.t_entry[index].move = move;
-    t_table.t_entry[index].score = score;
-    t_table.t_entry[index].depth = depth;
-    t_table.t_entry[index].flag = flag;
+    uint64 data = pack_entry(move, score, depth, flag);
+
+    t_table.t_entry[index].key = hash_key ^ data;
+    t_table.t_entry[index].data = data;
 }
 
 /**
@@ -142,7 +354,9 @@ void store_entry(TranspositionTable& t_table, unsigned int ply,
     @param beta is the current value of beta.
 
     @return bool denoting whether a hash hit occurred, that is, an entry with
-            depth greater than or equal to the current search depth was found.
+            depth greater than or equal to the current search depth was found
+            whose bound settles the search within the window. 'score' is then
+            the stored score itself, for a fail-soft search.
 
     @warning At least one flag must exist in the hash entry.
 */
@@ -151,38 +365,30 @@ bool probe_table(TranspositionTable& t_table, unsigned int ply,
     uint64 hash_key, unsigned int depth, unsigned int& pv_move, int& score,
     int alpha, int beta)
 {
-    unsigned int index = hash_key % t_table.num_entries;
-
-    assert(index < t_table.num_entries);
+    TableEntry entry;
 
-    if(t_table.t_entry[index].hash_key == hash_key)
+    if(read_entry(t_table, hash_key, entry))
     {
-        pv_move = t_table.t_entry[index].move;
+        pv_move = entry.move;
 
-        if(t_table.t_entry[index].depth >= depth)
+        if(entry.depth >= depth)
         {
-            score = t_table.t_entry[index].score;
+            score = entry.score;
 
             if(score > IS_MATE) score -= ply;
             else if(score < -IS_MATE) score += ply;
 
-            switch(t_table.t_entry[index].flag)
+            switch(entry.flag)
             {
-                case TFALPHA:
+                case TFALPHA: // Upper bound.
                 {
-                    if(score <= alpha)
-                    {
-                        score = alpha;
-                        return 1;
-                    }
+                    if(score <= alpha) return 1;
+                    break;
                 }
-                case TFBETA:
+                case TFBETA: // Lower bound.
                 {
-                    if(score >= beta)
-                    {
-                        score = beta;
-                        return 1;
-                    }
+                    if(score >= beta) return 1;
+                    break;
                 }
                 case TFEXACT:
                 {
@@ -210,12 +416,56 @@ bool probe_table(TranspositionTable& t_table, unsigned int ply,
 
 unsigned int probe_pv_table(TranspositionTable& t_table, uint64 hash_key)
 {
-    unsigned int index = hash_key % t_table.num_entries;
-
-    assert(index < t_table.num_entries);
+    TableEntry entry;
 
-    if(t_table.t_entry[index].hash_key == hash_key)
-        return t_table.t_entry[index].move;
+    if(read_entry(t_table, hash_key, entry)) return entry.move;
 
     return NO_MOVE;
+}
+
+/**
+    @brief Retrieve a copy of a hash entry if it exists in the table,
+           regardless of its depth, with mate scores adjusted to the current
+           ply.
+
+    @param t_table is the hash table to probe.
+    @param ply the current ply in search.
+    @param hash_key is the zobrist hash of the board to index the table with.
+    @param entry is the entry to copy into.
+
+    @return bool denoting whether an entry for the hash key was found.
+*/
+
+bool probe_entry(const TranspositionTable& t_table, unsigned int ply,
+    uint64 hash_key, TableEntry& entry)
+{
+    if(!read_entry(t_table, hash_key, entry)) return 0;
+
+    if(entry.score > IS_MATE) entry.score -= ply;
+    else if(entry.score < -IS_MATE) entry.score += ply;
+
+    return 1;
+}
+
+/**
+    @brief Estimates how full the table is by sampling its first thousand
+           entries, for the UCI 'hashfull' output.
+
+    @param t_table is the hash table to sample.
+
+    @return unsigned int denoting the occupancy of the table in permill.
+*/
+
+unsigned int hash_full(const TranspositionTable& t_table)
+{
+    unsigned int samples = t_table.num_entries < 1000 ?
+        t_table.num_entries : 1000;
+    unsigned int used = 0;
+
+    if(samples == 0) return 0;
+
+    for(unsigned int i = 0; i < samples; i++)
+        if(t_table.t_entry[i].data != 0ULL) used++;
+
+    return (used * 1000) / samples;
 }
\ No newline at end of file
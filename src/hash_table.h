@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename hash_table.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.5
 
     @brief Handles hash tables for efficient move searching.
 
@@ -14,6 +14,11 @@
     * 28/11/2015 0.1.0 Initial version.
     * 03/12/2015 0.1.1 Updated to a full transposition table.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 init_table() takes a 64-bit size.
+    * 17/10/2026 1.0.2 Added hash_full().
+    * 17/10/2026 1.0.3 Added probe_entry().
+    * 17/10/2026 1.0.4 Entries are stored in a lockless format, and tables may live in shared memory.
+    * 17/10/2026 1.0.5 init_table() returns whether the allocation succeeded, keeping the previous table if not.
 */
 
 /**
@@ -32,6 +37,8 @@
 
 #include "defs.h"
 
+#include <string> // std::string
+
 // Enumerations
 
 enum { TFALPHA = 1, TFBETA, TFEXACT }; // Flags
@@ -41,8 +48,8 @@ enum { TFALPHA = 1, TFBETA, TFEXACT }; // Flags
 /**
     @struct TableEntry
 
-    @brief Holds a bunch of information about previous searches, to be inserted
-           into the transposition table for future use.
+    @brief Holds a bunch of information about previous searches, as unpacked
+           from the transposition table.
 
     @var TableEntry::hash_key
          The zobrist hash of the board.
@@ -74,15 +81,46 @@ struct TableEntry
     {}
 };
 
+/**
+    @struct PackedEntry
+
+    @brief A transposition table entry as stored, in a lockless format.
+
+    The move, score, depth and flag are packed into one 64-bit word, and the
+    hash key is stored XORed with it. An entry torn by two concurrent writers
+    then fails to match its own key on probing and is ignored, so the table
+    can be shared by several searches without locks.
+
+    @var PackedEntry::key
+         The zobrist hash of the board, XORed with 'data'.
+    @var PackedEntry::data
+         The packed move (bits 0-22), flag (bits 23-24), depth (bits 25-31)
+         and score (bits 32-63).
+*/
+
+struct PackedEntry
+{
+    uint64 key; // Zobrist hash of the board, XORed with data.
+    uint64 data; // Packed move, flag, depth and score.
+
+    PackedEntry()
+    :key(0ULL), data(0ULL)
+    {}
+};
+
 /**
     @struct TranspositionTable
 
     @brief Stores a bunch of table entries for the transposition table.
 
     @var TranspositionTable::t_entry
-         The t_entry array, which is dynamically allocated.
+         The t_entry array, which is either dynamically allocated or mapped
+         from a named shared memory segment.
     @var TranspositionTable::num_entries
          The number of entries in the array.
+    @var TranspositionTable::map_size
+         The size in bytes of the shared memory mapping, or zero if the table
+         is private to this process.
 
     @warning Memory must be initialised.
     @warning num_entries musn't be changed after initialisation. If it is,
@@ -91,11 +129,12 @@ struct TableEntry
 
 struct TranspositionTable
 {
-    TableEntry* t_entry;
+    PackedEntry* t_entry;
     unsigned int num_entries;
+    uint64 map_size;
 
     TranspositionTable()
-    :t_entry(nullptr), num_entries(0)
+    :t_entry(nullptr), num_entries(0), map_size(0ULL)
     {}
 };
 
@@ -103,7 +142,12 @@ struct TranspositionTable
 
 // Initialise hash table.
 
-extern void init_table(TranspositionTable& t_table, unsigned int t_size);
+extern bool init_table(TranspositionTable& t_table, uint64 t_size);
+
+// Attach to a hash table in a named shared memory segment.
+
+extern bool init_shared_table(TranspositionTable& t_table, uint64 t_size,
+    const std::string& name);
 
 extern void free_table(TranspositionTable& t_table); // Free table memory.
 extern void clear_table(TranspositionTable& t_table); // Clear out the table.
@@ -120,6 +164,15 @@ extern bool probe_table(TranspositionTable& t_table, unsigned int ply,
     uint64 hash_key, unsigned int depth, unsigned int& pv_move, int& score,
     int alpha, int beta);
 
+// Retrieve a copy of a hash entry, whatever its depth.
+
+extern bool probe_entry(const TranspositionTable& t_table, unsigned int ply,
+    uint64 hash_key, TableEntry& entry);
+
+// Estimate how full the table is, in permill.
+
+extern unsigned int hash_full(const TranspositionTable& t_table);
+
 // Retrieve a PV move from the hash table.
 
 extern unsigned int probe_pv_table(TranspositionTable& t_table, uint64 hash_key);
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename lookup_tables.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.1
 
     @brief A collection of pre-calculated lookup tables for move generation.
            Based on Little-Endian Rank-File mapping (LERF).
@@ -12,6 +12,7 @@
     * 27/07/2015 0.1.0 Initial version.
     * 15/11/2015 0.1.2 Names are now more generic.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added BETWEEN_LT and init_between().
 */
 
 /**
@@ -29,6 +30,8 @@
 
 // Globals
 
+uint64 BETWEEN_LT[64][64]; // Cells between two cells, set by init_between().
+
 // Non-sliders
 
 const uint64 KING_LT[64] = { // King lookup.
@@ -356,4 +359,39 @@ const uint64 DIAG_SW_LT[64] = { // Southwest diagonal.
     0x0001000000000000ULL, 0x0002010000000000ULL, 0x0004020100000000ULL,
     0x0008040201000000ULL, 0x0010080402010000ULL, 0x0020100804020100ULL,
     0x0040201008040201ULL
-};
\ No newline at end of file
+};
+
+// Function definitions
+
+/**
+    @brief Initialises BETWEEN_LT from the directional ray lookups, so that
+           BETWEEN_BB() is a single table lookup.
+
+    @return void.
+*/
+
+void init_between()
+{
+    const uint64* const RAYS[8] = {LINE_N_LT, LINE_S_LT, LINE_E_LT,
+        LINE_W_LT, DIAG_NE_LT, DIAG_NW_LT, DIAG_SE_LT, DIAG_SW_LT};
+
+    for(unsigned int from = 0; from < 64; from++)
+    {
+        for(unsigned int to = 0; to < 64; to++)
+        {
+            BETWEEN_LT[from][to] = 0ULL;
+
+            // The ray from 'from' through 'to', less the part beyond it.
+
+            for(unsigned int i = 0; i < 8; i++)
+            {
+                if(RAYS[i][from] & GET_BB(to))
+                {
+                    BETWEEN_LT[from][to] = RAYS[i][from] & ~RAYS[i][to] &
+                        ~GET_BB(to);
+                    break;
+                }
+            }
+        }
+    }
+}
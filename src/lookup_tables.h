@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename lookup_tables.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.2
 
     @brief A collection of pre-calculated lookup tables for move generation.
            Based on Little-Endian Rank-File mapping (LERF).
@@ -12,6 +12,8 @@
     * 27/07/2015 0.1.0 Initial version.
     * 15/11/2015 0.1.2 Names are now more generic.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added BETWEEN_LT, init_between() and BETWEEN_BB(unsigned int, unsigned int).
+    * 17/10/2026 1.0.2 Added slider attack helpers for move generation.
 */
 
 /**
@@ -43,5 +45,91 @@ extern const uint64 DIAG_NE_LT[64]; // Northeast diagonal.
 extern const uint64 DIAG_NW_LT[64]; // Northwest diagonal.
 extern const uint64 DIAG_SE_LT[64]; // Southeast diagonal.
 extern const uint64 DIAG_SW_LT[64]; // Southwest diagonal.
+extern uint64 BETWEEN_LT[64][64]; // Cells between two cells.
+
+// External function declarations
+
+extern void init_between(); // Initialise BETWEEN_LT.
+
+// Helper functions
+
+/**
+    @brief Returns the cells strictly between two cells that share a line or
+           a diagonal, with a single lookup.
+
+    @param from is the index of the first cell in LERF layout.
+    @param to is the index of the second cell in LERF layout.
+
+    @return uint64 bitboard of the cells between 'from' and 'to', or zero if
+            they share neither a line nor a diagonal, or are adjacent.
+
+    @warning init_between() must've been called once before.
+*/
+
+inline uint64 BETWEEN_BB(unsigned int from, unsigned int to)
+{
+    assert(from < 64 && to < 64);
+
+    return BETWEEN_LT[from][to];
+}
+
+/**
+    @brief Returns the cells a slider on the given cell sees along one ray,
+           up to and including the first occupied cell.
+
+    @param ray is the directional lookup table to use, such as LINE_N_LT.
+    @param index is the index of the slider's cell in LERF layout.
+    @param occ is the bitboard of all occupied cells.
+    @param forward is set if the ray runs towards higher indices (north,
+           east, northeast and northwest), so that the nearest blocker is
+           the least significant bit.
+
+    @return uint64 bitboard of the cells attacked along the ray.
+*/
+
+inline uint64 RAY_ATTACKS_BB(const uint64* ray, unsigned int index, uint64 occ,
+    bool forward)
+{
+    const uint64 blockers = ray[index] & occ;
+
+    if(!blockers) return ray[index];
+
+    return ray[index] ^ ray[forward ? __builtin_ctzll(blockers) :
+        63 - __builtin_clzll(blockers)];
+}
+
+/**
+    @brief Returns the cells a rook on the given cell attacks.
+
+    @param index is the index of the rook's cell in LERF layout.
+    @param occ is the bitboard of all occupied cells.
+
+    @return uint64 bitboard of the attacked cells, including occupied ones.
+*/
+
+inline uint64 LINE_ATTACKS_BB(unsigned int index, uint64 occ)
+{
+    return RAY_ATTACKS_BB(LINE_N_LT, index, occ, 1) |
+        RAY_ATTACKS_BB(LINE_E_LT, index, occ, 1) |
+        RAY_ATTACKS_BB(LINE_S_LT, index, occ, 0) |
+        RAY_ATTACKS_BB(LINE_W_LT, index, occ, 0);
+}
+
+/**
+    @brief Returns the cells a bishop on the given cell attacks.
+
+    @param index is the index of the bishop's cell in LERF layout.
+    @param occ is the bitboard of all occupied cells.
+
+    @return uint64 bitboard of the attacked cells, including occupied ones.
+*/
+
+inline uint64 DIAG_ATTACKS_BB(unsigned int index, uint64 occ)
+{
+    return RAY_ATTACKS_BB(DIAG_NE_LT, index, occ, 1) |
+        RAY_ATTACKS_BB(DIAG_NW_LT, index, occ, 1) |
+        RAY_ATTACKS_BB(DIAG_SE_LT, index, occ, 0) |
+        RAY_ATTACKS_BB(DIAG_SW_LT, index, occ, 0);
+}
 
 #endif // LOOKUP_TABLES_H
\ No newline at end of file
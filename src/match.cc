@@ -0,0 +1,1042 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename match.cc
+    @author Shreyas Vinod
+    @version 0.1.5
+
+    @brief Plays matches between two engine configurations.
+
+    Plays games concurrently between two engines, either this engine with
+    different search parameters or external engines driven over UCI pipes.
+    Openings are drawn from an EPD file and played with both colours, games
+    are adjudicated, and the result is reported as an Elo difference with
+    error bars and a sequential probability ratio test (SPRT) verdict.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 The allotted time under a clock is now a soft limit.
+    * 17/10/2026 0.1.2 Hash table allocation failures are reported.
+    * 17/10/2026 0.1.3 sprt_llr() adds half a game to each outcome instead of returning zero until both sides have won a game.
+    * 17/10/2026 0.1.4 play_match() fails if an engine can't start or no game is played.
+    * 17/10/2026 0.1.5 The Elo interval uses the same half-game smoothing as sprt_llr().
+*/
+
+/**
+    @file
+    @filename match.cc
+    @author Shreyas Vinod
+
+    @brief Plays matches between two engine configurations.
+
+    Plays games concurrently between two engines, either this engine with
+    different search parameters or external engines driven over UCI pipes.
+    Openings are drawn from an EPD file and played with both colours, games
+    are adjudicated, and the result is reported as an Elo difference with
+    error bars and a sequential probability ratio test (SPRT) verdict.
+*/
+
+#include "defs.h"
+
+#include <iostream> // std::cout and std::cerr
+#include <sstream> // std::stringstream
+#include <string> // std::string
+#include <vector> // std::vector
+#include <thread> // std::thread and std::this_thread::sleep_for()
+#include <chrono> // std::chrono::milliseconds
+#include <mutex> // std::mutex and std::lock_guard
+#include <atomic> // std::atomic
+#include <cmath> // log(), log10(), pow() and sqrt()
+#include <csignal> // signal() and kill()
+#include <fcntl.h> // O_CLOEXEC
+#include <poll.h> // poll()
+#include <unistd.h> // fork(), pipe2(), execl(), read(), write() and close()
+#include <sys/wait.h> // waitpid()
+
+#include "match.h"
+#include "board.h"
+#include "move.h" // COORD_MOVE()
+#include "movegen.h" // gen_legal_moves()
+#include "search.h"
+#include "hash_table.h"
+#include "chronos.h" // Time and get_time_diff()
+#include "fen_reader.h"
+#include "packed_pos.h" // Game results
+
+// Macros
+
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+#define UCI_TIMEOUT 10000 // Time allowed for UCI handshakes in milliseconds.
+#define MOVE_OVERHEAD 50 // Time reserved per move for communication.
+
+// Enumerations
+
+enum { ENGINE_A, ENGINE_B };
+
+// Structures
+
+/**
+    @struct Player
+
+    @brief Holds one side of a match, which is either this engine searching
+           in-process or an external engine driven over UCI pipes.
+
+    @var Player::name
+         The name of the engine, for output.
+    @var Player::internal
+         Denotes whether the engine is this engine, searching in-process.
+    @var Player::params
+         The search parameters of an in-process engine.
+    @var Player::board
+         The board an in-process engine searches on, with its own
+         transposition table.
+    @var Player::path
+         The path of an external engine.
+    @var Player::pid
+         The process ID of an external engine.
+    @var Player::to_engine
+         The pipe to the standard input of an external engine.
+    @var Player::from_engine
+         The pipe from the standard output of an external engine.
+    @var Player::pending
+         Output read from an external engine that isn't a full line yet.
+*/
+
+struct Player
+{
+    std::string name;
+    bool internal;
+    SearchParams params;
+    Board board;
+    std::string path;
+    pid_t pid;
+    int to_engine;
+    int from_engine;
+    std::string pending;
+
+    Player()
+    :name(), internal(1), params(), board(), path(), pid(-1), to_engine(-1),
+        from_engine(-1), pending()
+    {}
+};
+
+/**
+    @struct MatchState
+
+    @brief Holds the state shared by all match threads.
+
+    @var MatchState::openings
+         The opening positions as FEN strings.
+    @var MatchState::lock
+         Guards the results and output.
+    @var MatchState::next
+         The index of the next game to be played.
+    @var MatchState::stop
+         Denotes whether the match should stop early.
+    @var MatchState::failed
+         Denotes whether an engine failed to start.
+    @var MatchState::wins
+         The number of games won by the first engine.
+    @var MatchState::draws
+         The number of drawn games.
+    @var MatchState::losses
+         The number of games lost by the first engine.
+*/
+
+struct MatchState
+{
+    std::vector<std::string> openings;
+    std::mutex lock;
+    std::atomic<unsigned int> next;
+    std::atomic<bool> stop;
+    std::atomic<bool> failed;
+    unsigned int wins;
+    unsigned int draws;
+    unsigned int losses;
+
+    MatchState()
+    :openings(), lock(), next(0), stop(false), failed(false), wins(0),
+        draws(0), losses(0)
+    {}
+};
+
+// Prototypes
+
+bool parse_engine(const std::string& spec, Player& player);
+bool send_line(Player& player, const std::string& line);
+bool read_line(Player& player, std::string& line, int timeout);
+bool wait_for(Player& player, const std::string& token);
+bool start_player(Player& player, const MatchOptions& options);
+void stop_player(Player& player);
+bool new_game(Player& player);
+inline uint64 time_for_move(long long clock, uint64 increment);
+bool player_move(Player& player, Board& game, const std::string& fen,
+    const std::vector<unsigned int>& moves, const MatchOptions& options,
+    const long long clock[2], unsigned int& move, int& score);
+int play_game(Player* players[2], const std::string& fen,
+    const MatchOptions& options, std::string& reason);
+bool load_openings(const std::string& epd_file,
+    std::vector<std::string>& openings);
+inline double elo_to_score(double elo);
+inline double score_to_elo(double score);
+double sprt_llr(unsigned int wins, unsigned int draws, unsigned int losses,
+    double elo0, double elo1);
+void print_standings(const MatchState& state, const MatchOptions& options);
+void match_worker(MatchState& state, const MatchOptions& options);
+bool play_match(const MatchOptions& options);
+
+// Function definitions
+
+/**
+    @brief Sets up a player from an engine specification, which is either
+           "self", optionally followed by search parameters as in
+           "self:null_reduction=3", or the path of a UCI engine.
+
+    @param spec is the engine specification.
+    @param player is the player to set up.
+
+    @return bool denoting whether the specification was understood.
+*/
+
+bool parse_engine(const std::string& spec, Player& player)
+{
+    player.name = spec;
+
+    if(spec == "self")
+    {
+        player.internal = 1;
+        return 1;
+    }
+
+    if(spec.compare(0, 5, "self:") == 0)
+    {
+        player.internal = 1;
+        return parse_search_params(spec.substr(5), player.params);
+    }
+
+    player.internal = 0;
+    player.path = spec;
+
+    return !spec.empty();
+}
+
+/**
+    @brief Sends a line to an external engine.
+
+    @param player is the external engine.
+    @param line is the line to send, without a line terminator.
+
+    @return bool denoting whether the line was sent.
+*/
+
+bool send_line(Player& player, const std::string& line)
+{
+    std::string buffer = line + "\n";
+    const char* data = buffer.data();
+    std::size_t left = buffer.length();
+
+    while(left)
+    {
+        ssize_t written = write(player.to_engine, data, left);
+        if(written <= 0) return 0;
+
+        data += written;
+        left -= written;
+    }
+
+    return 1;
+}
+
+/**
+    @brief Reads a line from an external engine.
+
+    @param player is the external engine.
+    @param line is the string to fill with the line, without the terminator.
+    @param timeout is the time to wait for a line in milliseconds.
+
+    @return bool denoting whether a line was read before the timeout, the
+            engine closing its output or an error.
+*/
+
+bool read_line(Player& player, std::string& line, int timeout)
+{
+    Time begin = get_cur_time();
+    std::size_t end;
+    char buffer[4096];
+
+    while((end = player.pending.find('\n')) == std::string::npos)
+    {
+        int remaining = timeout - int(get_time_diff(begin));
+        if(remaining <= 0) return 0;
+
+        pollfd poll_fd;
+        poll_fd.fd = player.from_engine;
+        poll_fd.events = POLLIN;
+        poll_fd.revents = 0;
+
+        if(poll(&poll_fd, 1, remaining) <= 0) return 0;
+
+        ssize_t n = read(player.from_engine, buffer, sizeof(buffer));
+        if(n <= 0) return 0;
+
+        player.pending.append(buffer, n);
+    }
+
+    line = player.pending.substr(0, end);
+    player.pending.erase(0, end + 1);
+
+    if(!line.empty() && line[line.length() - 1] == '\r')
+        line.erase(line.length() - 1);
+
+    return 1;
+}
+
+/**
+    @brief Reads lines from an external engine until one starts with the
+           given token, as when waiting for "uciok" or "readyok".
+
+    @param player is the external engine.
+    @param token is the token to wait for.
+
+    @return bool denoting whether the token arrived within 'UCI_TIMEOUT'.
+*/
+
+bool wait_for(Player& player, const std::string& token)
+{
+    std::string line;
+
+    while(read_line(player, line, UCI_TIMEOUT))
+        if(line.compare(0, token.length(), token) == 0) return 1;
+
+    return 0;
+}
+
+/**
+    @brief Gets a player ready to play. Allocates the transposition table of
+           an in-process engine, or launches an external engine and performs
+           the UCI handshake.
+
+    @param player is the player to start.
+    @param options is the match settings.
+
+    @return bool denoting whether the player is ready.
+*/
+
+bool start_player(Player& player, const MatchOptions& options)
+{
+    if(player.internal)
+    {
+        return init_table(player.board.t_table, options.hash_size);
+    }
+
+    int to_engine[2], from_engine[2];
+
+    // Close-on-exec, so that engines launched by other threads don't hold
+    // on to this engine's pipes.
+
+    if(pipe2(to_engine, O_CLOEXEC)) return 0;
+
+    if(pipe2(from_engine, O_CLOEXEC))
+    {
+        close(to_engine[0]);
+        close(to_engine[1]);
+        return 0;
+    }
+
+    player.pid = fork();
+
+    if(player.pid == 0) // Child
+    {
+        dup2(to_engine[0], STDIN_FILENO);
+        dup2(from_engine[1], STDOUT_FILENO);
+
+        execl(player.path.c_str(), player.path.c_str(),
+            static_cast<char*>(nullptr));
+        _exit(127); // Failed to launch.
+    }
+
+    close(to_engine[0]);
+    close(from_engine[1]);
+
+    player.to_engine = to_engine[1];
+    player.from_engine = from_engine[0];
+
+    if(player.pid < 0) return 0;
+
+    return send_line(player, "uci") && wait_for(player, "uciok") &&
+        send_line(player, "isready") && wait_for(player, "readyok");
+}
+
+/**
+    @brief Shuts a player down, freeing its transposition table or quitting
+           and reaping its engine process.
+
+    @param player is the player to stop.
+
+    @return void.
+*/
+
+void stop_player(Player& player)
+{
+    if(player.internal)
+    {
+        free_table(player.board.t_table);
+        return;
+    }
+
+    if(player.to_engine >= 0)
+    {
+        send_line(player, "quit");
+        close(player.to_engine);
+    }
+
+    if(player.from_engine >= 0) close(player.from_engine);
+
+    if(player.pid > 0)
+    {
+        // Give the engine a second to quit, then kill it.
+
+        Time begin = get_cur_time();
+
+        while(waitpid(player.pid, nullptr, WNOHANG) == 0)
+        {
+            if(get_time_diff(begin) > 1000)
+            {
+                kill(player.pid, SIGKILL);
+                waitpid(player.pid, nullptr, 0);
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    player.to_engine = player.from_engine = -1;
+    player.pid = -1;
+}
+
+/**
+    @brief Tells a player that a new game is starting.
+
+    @param player is the player.
+
+    @return bool denoting whether the player is ready for the new game.
+*/
+
+bool new_game(Player& player)
+{
+    if(player.internal)
+    {
+        clear_table(player.board.t_table);
+        return 1;
+    }
+
+    return send_line(player, "ucinewgame") && send_line(player, "isready") &&
+        wait_for(player, "readyok");
+}
+
+/**
+    @brief Allocates time for a move under a clock, much like the UCI 'go'
+           command does.
+
+    @param clock is the time left on the clock in milliseconds.
+    @param increment is the increment per move in milliseconds.
+
+    @return uint64 denoting the time to spend on the move in milliseconds.
+*/
+
+inline uint64 time_for_move(long long clock, uint64 increment)
+{
+    long long time = (clock / 30) + increment - MOVE_OVERHEAD;
+
+    if(time > clock - MOVE_OVERHEAD) time = clock - MOVE_OVERHEAD;
+    if(time < 1) time = 1;
+
+    return time;
+}
+
+/**
+    @brief Asks a player for its move in the current game.
+
+    @param player is the player to move.
+    @param game is the board of the game.
+    @param fen is the opening position of the game.
+    @param moves is the list of moves played since the opening position.
+    @param options is the match settings.
+    @param clock is the time left on each clock in milliseconds, indexed by
+           side.
+    @param move is set to the move chosen.
+    @param score is set to the score the player reported, from its point of
+           view, or zero if it reported none.
+
+    @return bool denoting whether the player produced a move in time.
+*/
+
+bool player_move(Player& player, Board& game, const std::string& fen,
+    const std::vector<unsigned int>& moves, const MatchOptions& options,
+    const long long clock[2], unsigned int& move, int& score)
+{
+    move = NO_MOVE;
+    score = 0;
+
+    if(player.internal)
+    {
+        unsigned int fen_index = 0;
+        parse_fen(player.board, fen, fen_index);
+
+        for(unsigned int i = 0; i < moves.size(); i++)
+            make_move(player.board, moves[i]);
+
+        SearchInfo search_info;
+        search_info.silent = 1;
+        search_info.params = player.params;
+        search_info.depth = MAX_DEPTH - 1;
+
+        if(options.depth)
+        {
+            search_info.depth_set = 1;
+            search_info.depth = options.depth;
+        }
+
+        if(options.nodes)
+        {
+            search_info.nodes_set = 1;
+            search_info.max_nodes = options.nodes;
+        }
+
+        if(options.move_time)
+        {
+            search_info.time_set = 1;
+            search_info.move_time = options.move_time;
+        }
+        else if(options.base_time)
+        {
+            // As with the UCI 'go' command, the allotted time is a soft limit
+            // that may be exceeded up to three times over, but never beyond
+            // half the clock.
+
+            long long max_time = clock[game.side] / 2 - MOVE_OVERHEAD;
+
+            search_info.time_set = 1;
+            search_info.soft_time =
+                time_for_move(clock[game.side], options.increment);
+            search_info.move_time = search_info.soft_time * 3;
+
+            if(max_time < 1) max_time = 1;
+            if(search_info.move_time > uint64(max_time))
+                search_info.move_time = max_time;
+            if(search_info.soft_time > search_info.move_time)
+                search_info.soft_time = search_info.move_time;
+        }
+
+        search_info.start_time = get_cur_time();
+        search(player.board, search_info);
+
+        move = search_info.best_move;
+        score = search_info.best_score;
+
+        return move != NO_MOVE;
+    }
+
+    // External engine
+
+    std::stringstream cmd;
+
+    cmd << "position fen " << fen;
+
+    if(!moves.empty())
+    {
+        cmd << " moves";
+
+        for(unsigned int i = 0; i < moves.size(); i++)
+            cmd << " " << COORD_MOVE(moves[i]);
+    }
+
+    if(!send_line(player, cmd.str())) return 0;
+
+    cmd.str("");
+    cmd << "go";
+
+    if(options.depth) cmd << " depth " << options.depth;
+    if(options.nodes) cmd << " nodes " << options.nodes;
+    if(options.move_time) cmd << " movetime " << options.move_time;
+
+    if(options.base_time)
+    {
+        cmd << " wtime " << clock[WHITE] << " btime " << clock[BLACK] <<
+            " winc " << options.increment << " binc " << options.increment;
+    }
+
+    if(!send_line(player, cmd.str())) return 0;
+
+    // Wait for the move, noting scores along the way. Under a time limit,
+    // a second of grace is allowed before the engine is forfeited.
+
+    int timeout = 600000;
+
+    if(options.move_time) timeout = options.move_time + 1000;
+    else if(options.base_time) timeout = clock[game.side] + 1000;
+
+    std::string line, token;
+    Time begin = get_cur_time();
+
+    while(read_line(player, line, timeout - int(get_time_diff(begin))))
+    {
+        std::stringstream tokens(line);
+        tokens >> token;
+
+        if(token == "info")
+        {
+            while(tokens >> token)
+            {
+                if(token != "score") continue;
+
+                int value;
+                tokens >> token >> value;
+
+                if(token == "cp") score = value;
+                else if(token == "mate" && value > 0)
+                    score = INFINITY_C - value;
+                else if(token == "mate") score = -INFINITY_C - value;
+            }
+        }
+        else if(token == "bestmove")
+        {
+            if(!(tokens >> token)) return 0;
+
+            move = parse_move(game, token);
+
+            return move != NO_MOVE;
+        }
+    }
+
+    return 0;
+}
+
+/**
+    @brief Plays a game between two players.
+
+    @param players is the two players, indexed by side.
+    @param fen is the opening position.
+    @param options is the match settings.
+    @param reason is set to a short description of how the game ended.
+
+    @return int denoting the result of the game from white's point of view;
+            RESULT_LOSS, RESULT_DRAW or RESULT_WIN.
+*/
+
+int play_game(Player* players[2], const std::string& fen,
+    const MatchOptions& options, std::string& reason)
+{
+    Board game;
+    unsigned int fen_index = 0, move;
+    int score, winner = -1;
+    unsigned int resign_count = 0, draw_count = 0;
+    std::vector<unsigned int> moves;
+    long long clock[2];
+
+    parse_fen(game, fen, fen_index);
+    clock[WHITE] = clock[BLACK] = options.base_time;
+
+    for(unsigned int i = 0; i < 2; i++)
+    {
+        if(new_game(*players[i])) continue;
+
+        reason = players[i]->name + " is not responding";
+        return (i == WHITE) ? RESULT_LOSS : RESULT_WIN;
+    }
+
+    while(1)
+    {
+        bool side = game.side;
+        int loss = (side == WHITE) ? RESULT_LOSS : RESULT_WIN;
+
+        // Natural ends
+
+        if(gen_legal_moves(game).list.empty())
+        {
+            if(!is_in_check(game))
+            {
+                reason = "stalemate";
+                return RESULT_DRAW;
+            }
+
+            reason = (side == WHITE) ? "black mates" : "white mates";
+            return loss;
+        }
+
+        if(is_drawn(game))
+        {
+            reason = "draw by rule";
+            return RESULT_DRAW;
+        }
+
+        if(moves.size() >= options.max_plies)
+        {
+            reason = "draw by length";
+            return RESULT_DRAW;
+        }
+
+        // Get a move.
+
+        Time begin = get_cur_time();
+
+        if(!player_move(*players[side], game, fen, moves, options, clock,
+            move, score))
+        {
+            reason = players[side]->name + " failed to move";
+            return loss;
+        }
+
+        if(options.base_time)
+        {
+            clock[side] -= get_time_diff(begin);
+
+            if(clock[side] < 0)
+            {
+                reason = players[side]->name + " lost on time";
+                return loss;
+            }
+
+            clock[side] += options.increment;
+        }
+
+        if(!make_move(game, move))
+        {
+            reason = players[side]->name + " made an illegal move";
+            return loss;
+        }
+
+        moves.push_back(move);
+
+        // Adjudication, once both sides agree on the score for long enough.
+
+        int ahead = -1; // The side the score says is winning, if any.
+
+        if(score >= options.resign_score) ahead = side;
+        else if(score <= -options.resign_score) ahead = !side;
+
+        if(ahead != -1 && ahead == winner) resign_count++;
+        else resign_count = (ahead != -1);
+
+        winner = ahead;
+
+        if(options.resign_moves && resign_count >= 2 * options.resign_moves)
+        {
+            reason = (winner == WHITE) ? "black resigns" : "white resigns";
+            return (winner == WHITE) ? RESULT_WIN : RESULT_LOSS;
+        }
+
+        if(moves.size() >= options.draw_start &&
+            score <= options.draw_score && score >= -options.draw_score)
+            draw_count++;
+        else draw_count = 0;
+
+        if(options.draw_moves && draw_count >= 2 * options.draw_moves)
+        {
+            reason = "draw by adjudication";
+            return RESULT_DRAW;
+        }
+    }
+}
+
+/**
+    @brief Loads opening positions from an EPD file.
+
+    @param epd_file is the path of the EPD file.
+    @param openings is the list to fill with FEN strings, with move counters
+           added where the EPD lacks them.
+
+    @return bool denoting whether the file could be read and held at least
+            one valid position.
+*/
+
+bool load_openings(const std::string& epd_file,
+    std::vector<std::string>& openings)
+{
+    FenReader epd;
+
+    if(!open_reader(epd, epd_file)) return 0;
+
+    StrSlice line;
+    Board board;
+    std::string token, fen;
+
+    while(next_line(epd, line))
+    {
+        std::stringstream fields(std::string(line.data, line.length));
+        fen.clear();
+
+        for(unsigned int i = 0; i < 4 && fields >> token; i++)
+            fen += (i ? " " : "") + token;
+
+        // Keep the move counters, if any.
+
+        std::string fifty, move_num;
+
+        if(fields >> fifty >> move_num &&
+            fifty.find_first_not_of("0123456789") == std::string::npos &&
+            move_num.find_first_not_of("0123456789") == std::string::npos)
+            fen += " " + fifty + " " + move_num;
+        else fen += " 0 1";
+
+        unsigned int fen_index = 0;
+        if(parse_fen(board, fen, fen_index)) openings.push_back(fen);
+    }
+
+    close_reader(epd);
+
+    return !openings.empty();
+}
+
+/**
+    @brief Converts an Elo difference into an expected score.
+
+    @param elo is the Elo difference.
+
+    @return double denoting the expected score, between zero and one.
+*/
+
+inline double elo_to_score(double elo)
+{
+    return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+/**
+    @brief Converts a score into an Elo difference.
+
+    @param score is the score, strictly between zero and one.
+
+    @return double denoting the Elo difference.
+*/
+
+inline double score_to_elo(double score)
+{
+    return 400.0 * log10(score / (1.0 - score));
+}
+
+/**
+    @brief Computes the log-likelihood ratio of the SPRT, using the normal
+           approximation to the trinomial distribution of game results.
+
+    Half a game is added to each outcome when estimating the score and its
+    variance, so that a match one engine never loses, or never wins, still
+    has a finite, non-zero variance and can reach either bound.
+
+    @param wins is the number of games won.
+    @param draws is the number of games drawn.
+    @param losses is the number of games lost.
+    @param elo0 is the Elo difference of the null hypothesis.
+    @param elo1 is the Elo difference of the alternative hypothesis.
+
+    @return double denoting the log-likelihood ratio.
+*/
+
+double sprt_llr(unsigned int wins, unsigned int draws, unsigned int losses,
+    double elo0, double elo1)
+{
+    if(wins + draws + losses == 0) return 0.0; // No information yet.
+
+    double games = wins + draws + losses;
+    double w = wins + 0.5, d = draws + 0.5, l = losses + 0.5, n = games + 1.5;
+
+    double score = (w + d / 2.0) / n;
+    double variance = (w * pow(1.0 - score, 2) + d * pow(0.5 - score, 2) +
+        l * pow(score, 2)) / n;
+
+    double s0 = elo_to_score(elo0), s1 = elo_to_score(elo1);
+
+    return games * (s1 - s0) * (2 * score - s0 - s1) / (2 * variance);
+}
+
+/**
+    @brief Prints the standings of a match; the score, the Elo difference
+           with its approximate 95% confidence interval and the state of the
+           SPRT.
+
+    @param state is the shared match state.
+    @param options is the match settings.
+
+    @return void.
+
+    @warning The caller must hold 'state.lock'.
+*/
+
+void print_standings(const MatchState& state, const MatchOptions& options)
+{
+    unsigned int games = state.wins + state.draws + state.losses;
+    if(games == 0) return;
+
+    double score = (state.wins + state.draws / 2.0) / games;
+
+    // The variance adds half a game to each outcome, as in sprt_llr(), so
+    // that a run of one result doesn't claim a zero-width interval.
+
+    double w = state.wins + 0.5, d = state.draws + 0.5, l = state.losses + 0.5;
+    double n = games + 1.5, mean = (w + d / 2.0) / n;
+    double variance = (w * pow(1.0 - mean, 2) + d * pow(0.5 - mean, 2) +
+        l * pow(mean, 2)) / n;
+    double margin = 1.96 * sqrt(variance / games);
+
+    std::cout << "Score of " << options.engines[ENGINE_A] << " vs " <<
+        options.engines[ENGINE_B] << ": " << state.wins << " - " <<
+        state.losses << " - " << state.draws << " [" << score << "] " <<
+        games << std::endl;
+
+    if(score > 0.0 && score < 1.0)
+    {
+        double low = score - margin, high = score + margin;
+
+        std::cout << "Elo difference: " << score_to_elo(score) << " [" <<
+            (low > 0.0 ? score_to_elo(low) : -INFINITY) << ", " <<
+            (high < 1.0 ? score_to_elo(high) : INFINITY) << "]" << std::endl;
+    }
+    else std::cout << "Elo difference: " << (score > 0.0 ? "+" : "-") <<
+        "inf" << std::endl;
+
+    double llr = sprt_llr(state.wins, state.draws, state.losses, options.elo0,
+        options.elo1);
+    double lower = log(options.beta / (1.0 - options.alpha));
+    double upper = log((1.0 - options.beta) / options.alpha);
+
+    std::cout << "SPRT: elo0 " << options.elo0 << " elo1 " << options.elo1 <<
+        " llr " << llr << " [" << lower << ", " << upper << "] ";
+
+    if(llr >= upper) std::cout << "H1 accepted" << std::endl;
+    else if(llr <= lower) std::cout << "H0 accepted" << std::endl;
+    else std::cout << "inconclusive" << std::endl;
+}
+
+/**
+    @brief Match thread. Launches its own pair of players and plays games
+           until the shared game count runs out or the match is stopped.
+
+    @param state is the shared match state.
+    @param options is the match settings.
+
+    @return void.
+*/
+
+void match_worker(MatchState& state, const MatchOptions& options)
+{
+    Player players[2];
+
+    for(unsigned int i = 0; i < 2; i++)
+    {
+        if(parse_engine(options.engines[i], players[i]) &&
+            start_player(players[i], options)) continue;
+
+        std::lock_guard<std::mutex> lock(state.lock);
+        std::cerr << "ERROR: Unable to start engine \"" <<
+            options.engines[i] << "\"." << std::endl;
+
+        state.failed = 1;
+        state.stop = 1;
+    }
+
+    unsigned int game;
+    std::string reason;
+    Player* colours[2];
+
+    while(!state.stop && (game = state.next++) < options.games)
+    {
+        // Every opening is played twice, with colours reversed.
+
+        const std::string& fen =
+            state.openings[(game / 2) % state.openings.size()];
+        bool a_white = (game % 2 == 0);
+
+        colours[WHITE] = &players[a_white ? ENGINE_A : ENGINE_B];
+        colours[BLACK] = &players[a_white ? ENGINE_B : ENGINE_A];
+
+        int result = play_game(colours, fen, options, reason);
+        int a_result = a_white ? result : -result;
+
+        std::lock_guard<std::mutex> lock(state.lock);
+
+        if(a_result == RESULT_WIN) state.wins++;
+        else if(a_result == RESULT_LOSS) state.losses++;
+        else state.draws++;
+
+        std::cout << "Finished game " << game + 1 << " (" <<
+            colours[WHITE]->name << " vs " << colours[BLACK]->name << "): " <<
+            (result == RESULT_WIN ? "1-0" :
+            result == RESULT_LOSS ? "0-1" : "1/2-1/2") << " {" << reason <<
+            "}" << std::endl;
+
+        unsigned int played = state.wins + state.draws + state.losses;
+
+        if(played % 10 == 0) print_standings(state, options);
+
+        if(options.sprt_stop)
+        {
+            double llr = sprt_llr(state.wins, state.draws, state.losses,
+                options.elo0, options.elo1);
+
+            if(llr >= log((1.0 - options.beta) / options.alpha) ||
+                llr <= log(options.beta / (1.0 - options.alpha)))
+                state.stop = 1;
+        }
+    }
+
+    for(unsigned int i = 0; i < 2; i++) stop_player(players[i]);
+}
+
+/**
+    @brief Plays a match between two engines on a pool of threads and
+           reports the result.
+
+    @param options is the match settings.
+
+    @return bool denoting whether the match took place, that is, whether
+            the openings could be loaded, every engine started and at least
+            one game was played. The standings of any games played are
+            printed either way.
+
+    @warning Each thread launches its own pair of engines.
+*/
+
+bool play_match(const MatchOptions& options)
+{
+    MatchState state;
+    MatchOptions opts = options;
+
+    if(opts.openings.empty()) state.openings.push_back(START_FEN);
+    else if(!load_openings(opts.openings, state.openings))
+    {
+        std::cerr << "ERROR: Unable to load openings from \"" <<
+            opts.openings << "\"." << std::endl;
+        return 0;
+    }
+
+    if(!opts.depth && !opts.nodes && !opts.move_time && !opts.base_time)
+    {
+        opts.base_time = 10000;
+        opts.increment = 100;
+    }
+
+    if(opts.concurrency == 0) opts.concurrency = 1;
+    if(opts.concurrency > opts.games) opts.concurrency = opts.games;
+
+    signal(SIGPIPE, SIG_IGN); // Report engines that die, rather than dying.
+
+    std::cout << "Playing " << opts.games << " games of " <<
+        opts.engines[ENGINE_A] << " vs " << opts.engines[ENGINE_B] <<
+        " with " << state.openings.size() << " openings, " <<
+        opts.concurrency << " at a time." << std::endl;
+
+    std::vector<std::thread> workers;
+
+    for(unsigned int i = 0; i < opts.concurrency; i++)
+    {
+        workers.push_back(std::thread(match_worker, std::ref(state),
+            std::cref(opts)));
+    }
+
+    for(unsigned int i = 0; i < workers.size(); i++) workers.at(i).join();
+
+    std::cout << std::endl;
+    print_standings(state, opts);
+
+    return !state.failed && state.wins + state.draws + state.losses > 0;
+}
@@ -0,0 +1,142 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename match.h
+    @author Shreyas Vinod
+    @version 0.1.1
+
+    @brief Plays matches between two engine configurations.
+
+    Plays games concurrently between two engines, either this engine with
+    different search parameters or external engines driven over UCI pipes.
+    Openings are drawn from an EPD file and played with both colours, games
+    are adjudicated, and the result is reported as an Elo difference with
+    error bars and a sequential probability ratio test (SPRT) verdict.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 MatchOptions::hash_size is 64-bit.
+*/
+
+/**
+    @file
+    @filename match.h
+    @author Shreyas Vinod
+
+    @brief Plays matches between two engine configurations.
+
+    Plays games concurrently between two engines, either this engine with
+    different search parameters or external engines driven over UCI pipes.
+    Openings are drawn from an EPD file and played with both colours, games
+    are adjudicated, and the result is reported as an Elo difference with
+    error bars and a sequential probability ratio test (SPRT) verdict.
+*/
+
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "defs.h"
+
+#include <string> // std::string
+
+// Structures
+
+/**
+    @struct MatchOptions
+
+    @brief Holds the settings for a match.
+
+    @var MatchOptions::engines
+         The two engines. "self" denotes this engine, and may be followed by
+         search parameters, as in "self:null_reduction=3". Anything else is
+         the path of a UCI engine.
+    @var MatchOptions::games
+         The number of games to play.
+    @var MatchOptions::concurrency
+         The number of games played at once.
+    @var MatchOptions::openings
+         The EPD file to draw openings from, or an empty string to play from
+         the start position.
+    @var MatchOptions::depth
+         The depth to search every move to, or zero if unlimited.
+    @var MatchOptions::nodes
+         The node budget per move, or zero if unlimited.
+    @var MatchOptions::move_time
+         The time budget per move in milliseconds, or zero if unlimited.
+    @var MatchOptions::base_time
+         The time on each clock at the start of the game in milliseconds,
+         or zero if there are no clocks.
+    @var MatchOptions::increment
+         The time added to a clock after every move in milliseconds.
+    @var MatchOptions::hash_size
+         The size of each in-process engine's transposition table in bytes.
+    @var MatchOptions::max_plies
+         The length in plies after which a game is adjudicated a draw.
+    @var MatchOptions::resign_score
+         The score both engines must agree on for a game to be resigned.
+    @var MatchOptions::resign_moves
+         The number of consecutive moves, by each side, the resign score must
+         be held for.
+    @var MatchOptions::draw_score
+         The absolute score both engines must stay within for a game to be
+         adjudicated a draw.
+    @var MatchOptions::draw_moves
+         The number of consecutive moves, by each side, the draw score must be
+         held for.
+    @var MatchOptions::draw_start
+         The ply from which draw adjudication is allowed.
+    @var MatchOptions::elo0
+         The Elo difference of the null hypothesis of the SPRT.
+    @var MatchOptions::elo1
+         The Elo difference of the alternative hypothesis of the SPRT.
+    @var MatchOptions::alpha
+         The false positive rate of the SPRT.
+    @var MatchOptions::beta
+         The false negative rate of the SPRT.
+    @var MatchOptions::sprt_stop
+         Denotes whether to stop the match as soon as the SPRT concludes.
+
+    @warning If no depth, node or time budget is set, the match is played at
+             ten seconds per game plus a tenth of a second per move.
+*/
+
+struct MatchOptions
+{
+    std::string engines[2];
+    unsigned int games;
+    unsigned int concurrency;
+    std::string openings;
+    unsigned int depth;
+    uint64 nodes;
+    uint64 move_time;
+    uint64 base_time;
+    uint64 increment;
+    uint64 hash_size;
+    unsigned int max_plies;
+    int resign_score;
+    unsigned int resign_moves;
+    int draw_score;
+    unsigned int draw_moves;
+    unsigned int draw_start;
+    double elo0;
+    double elo1;
+    double alpha;
+    double beta;
+    bool sprt_stop;
+
+    MatchOptions()
+    :engines(), games(100), concurrency(1), openings(), depth(0), nodes(0),
+        move_time(0), base_time(0), increment(0), hash_size(16777216),
+        max_plies(500), resign_score(1000), resign_moves(3), draw_score(10),
+        draw_moves(8), draw_start(80), elo0(0.0), elo1(5.0), alpha(0.05),
+        beta(0.05), sprt_stop(0)
+    {}
+};
+
+// External function declarations
+
+// Play a match between two engines and report the result.
+
+extern bool play_match(const MatchOptions& options);
+
+#endif // MATCH_H
@@ -2,129 +2,232 @@
     Cortex - Self-learning Chess Engine
     @filename misc.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.1.1
 
-    @brief An embarrassing file using C with code by Oliver Brausch,
-           to check for input waiting.
+    @brief Handles standard input for the UCI protocol.
 
-    @see http://home.arcor.de/dreamlike/chess/.
+    A single reader thread reads standard input line by line into a
+    lock-free single-producer, single-consumer command queue, which the UCI
+    loop and the search both consume. Standard input is never read from
+    anywhere else, so no command is ever lost to another reader's buffer.
 
     ******************** VERSION CONTROL ********************
     * 05/12/2015 File created.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.1.0 Replaced select() polling with a reader thread and a
+                       command queue.
+        * Commands other than 'stop', 'quit' and 'isready' that arrive
+          during a search now stop it and are kept for the UCI loop.
+    * 17/10/2026 1.1.1 Only 'stop' and 'quit' stop a UCI search; other commands wait until it's over.
+        * peek_input() can look past the next command.
 */
 
 /**
     @file
-    @filename misc.cpp
+    @filename misc.cc
     @author Shreyas Vinod
 
-    @brief An embarrassing file using C with code by Oliver Brausch,
-           to check for input waiting.
+    @brief Handles standard input for the UCI protocol.
 
-    @see http://home.arcor.de/dreamlike/chess/.
+    A single reader thread reads standard input line by line into a
+    lock-free single-producer, single-consumer command queue, which the UCI
+    loop and the search both consume. Standard input is never read from
+    anywhere else, so no command is ever lost to another reader's buffer.
 */
 
 #include "defs.h"
 
-#include <cstdio>
-#include <string.h>
-
-#ifdef WIN32
-#include "windows.h"
-#include "unistd.h"
-#else
-#include "sys/time.h"
-#include "sys/select.h"
-#endif // #ifdef WIN32
+#include <iostream> // std::cin and std::cout
+#include <string> // std::string
+#include <thread> // std::thread
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include <chrono> // std::chrono::milliseconds
 
 #include "misc.h"
 #include "search.h"
 
+// Globals
+
+// The command queue. The reader thread is the only producer, advancing
+// 'input_tail'; the UCI thread is the only consumer, advancing 'input_head'.
+
+std::string input_queue[INPUT_QUEUE_SIZE];
+std::atomic<unsigned int> input_head(0);
+std::atomic<unsigned int> input_tail(0);
+
+// Only used to sleep while the queue is empty; never taken to access it.
+
+std::mutex input_mutex;
+std::condition_variable input_ready;
+
 // Prototypes
 
-bool input_waiting();
+void input_reader();
+void start_input();
+bool next_input(std::string& line, bool wait);
+bool peek_input(std::string& line, unsigned int ahead);
 void read_input(SearchInfo& search_info);
 
 // Function definitions
 
 /**
-    @brief Checks if there's input waiting on stdin.
+    @brief Reads standard input line by line into the command queue until
+           end of file, then queues a 'quit'. Runs on its own thread.
+
+    @return void.
 
-    @return bool denoting whether there is input waiting on stdin.
+    @warning Waits for the consumer if the queue is full.
 */
 
-bool input_waiting()
+void input_reader()
 {
-#ifndef WIN32
-    fd_set readfds;
-    struct timeval tv;
-    FD_ZERO(&readfds);
-    FD_SET(fileno(stdin), &readfds);
-    tv.tv_sec = 0; tv.tv_usec = 0;
-    select(16, &readfds, nullptr, nullptr, &tv);
-
-    return (FD_ISSET(fileno(stdin), &readfds));
-#else
-    static int init = 0, pipe;
-    static HANDLE inh;
-    DWORD dw;
-
-    if(!init)
+    std::string line;
+    bool eof = 0;
+
+    while(!eof)
     {
-        init = 1;
-        inh = GetStdHandle(STD_INPUT_HANDLE);
-        pipe = !GetConsoleMode(inh, &dw);
-        if(!pipe)
+        if(!std::getline(std::cin, line))
         {
-            SetConsoleMode(inh, dw & ~(ENABLE_MOUSE_INPUT|ENABLE_WINDOW_INPUT));
-            FlushConsoleInputBuffer(inh);
+            line = "quit"; // The GUI has gone away.
+            eof = 1;
         }
+
+        if(!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+
+        unsigned int tail = input_tail.load(std::memory_order_relaxed);
+
+        while(tail - input_head.load(std::memory_order_acquire) ==
+            INPUT_QUEUE_SIZE)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        input_queue[tail & (INPUT_QUEUE_SIZE - 1)].swap(line);
+        input_tail.store(tail + 1, std::memory_order_release);
+
+        // Taking the lock orders the notification after a consumer that is
+        // about to sleep has checked the queue, so no wake-up is lost.
+
+        {
+            std::lock_guard<std::mutex> lock(input_mutex);
+        }
+
+        input_ready.notify_one();
     }
-    if(pipe)
-    {
-        if(!PeekNamedPipe(inh, NULL, 0, NULL, &dw, NULL)) return 1;
-        return dw;
-    }
-    else
+}
+
+/**
+    @brief Starts the thread reading standard input into the command queue.
+
+    @return void.
+
+    @warning Must be called once, before any other function here is used.
+             Standard input must not be read elsewhere afterwards.
+*/
+
+void start_input()
+{
+    std::cin.tie(nullptr); // Output is flushed explicitly.
+    std::thread(input_reader).detach();
+}
+
+/**
+    @brief Takes the next command off the queue.
+
+    @param line is the string to store the command in.
+    @param wait denotes whether to wait for a command if the queue is empty.
+
+    @return bool denoting whether a command was taken off the queue.
+*/
+
+bool next_input(std::string& line, bool wait)
+{
+    unsigned int head = input_head.load(std::memory_order_relaxed);
+
+    if(head == input_tail.load(std::memory_order_acquire))
     {
-        GetNumberOfConsoleInputEvents(inh, &dw);
-        return dw <= 1 ? 0 : dw;
+        if(!wait) return 0;
+
+        std::unique_lock<std::mutex> lock(input_mutex);
+        input_ready.wait(lock, [head]
+            { return head != input_tail.load(std::memory_order_acquire); });
     }
-#endif // WIN32
+
+    line.swap(input_queue[head & (INPUT_QUEUE_SIZE - 1)]);
+    input_head.store(head + 1, std::memory_order_release);
+
+    return 1;
+}
+
+/**
+    @brief Looks at a command on the queue without taking it off.
+
+    @param line is the string to copy the command into.
+    @param ahead is the number of commands before it on the queue; zero for
+           the next command.
+
+    @return bool denoting whether there was such a command on the queue.
+*/
+
+bool peek_input(std::string& line, unsigned int ahead)
+{
+    unsigned int head = input_head.load(std::memory_order_relaxed);
+
+    if(input_tail.load(std::memory_order_acquire) - head <= ahead) return 0;
+
+    line = input_queue[(head + ahead) & (INPUT_QUEUE_SIZE - 1)];
+
+    return 1;
 }
 
 /**
-    @brief Reads input from stdin if any is waiting, and appropriately
+    @brief Handles commands that arrived during a search, and appropriately
            sets the stop/quit flags in the search information structure.
 
     @param search_info is the search information structure.
 
     @return void.
+
+    @warning Other commands are left on the queue, to be handled once the
+             search is over. A 'stop' or 'quit' queued behind them, before
+             the next 'go', still stops the search. In interactive searches,
+             any command stops it.
 */
 
 void read_input(SearchInfo& search_info)
 {
-    int bytes;
-    char input[256] = "", *endc;
+    std::string line;
 
-    if(input_waiting())
+    while(peek_input(line, 0))
     {
-        search_info.stopped = 1;
-        do
+        if(line == "isready")
         {
-            bytes = read(fileno(stdin), input, 256);
-        } while (bytes < 0);
-        endc = strchr(input, '\n');
-        if(endc) *endc=0;
-
-        if(strlen(input) > 0)
+            std::cout << "readyok" << std::endl;
+        }
+        else if(line == "quit")
+        {
+            search_info.stopped = 1;
+            search_info.quit = 1;
+        }
+        else if(line == "stop") search_info.stopped = 1;
+        else if(!line.empty())
         {
-            if(!strncmp(input, "quit", 4))
+            if(search_info.interactive) search_info.stopped = 1;
+
+            // Look past the waiting commands for one meant for this search.
+
+            for(unsigned int i = 1; !search_info.stopped &&
+                peek_input(line, i) && line.compare(0, 2, "go"); i++)
             {
-                search_info.quit = 1;
+                if(line == "stop" || line == "quit") search_info.stopped = 1;
             }
+
+            return;
         }
-        return;
+
+        next_input(line, 0);
     }
 }
\ No newline at end of file
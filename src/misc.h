@@ -2,16 +2,20 @@
     Cortex - Self-learning Chess Engine
     @filename misc.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.1.0
 
-    @brief An embarrassing file using C with code by Oliver Brausch,
-           to check for input waiting.
+    @brief Handles standard input for the UCI protocol.
 
-    @see http://home.arcor.de/dreamlike/chess/.
+    A single reader thread reads standard input line by line into a
+    lock-free single-producer, single-consumer command queue, which the UCI
+    loop and the search both consume. Standard input is never read from
+    anywhere else, so no command is ever lost to another reader's buffer.
 
     ******************** VERSION CONTROL ********************
     * 05/12/2015 File created.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.1.0 Replaced select() polling with a reader thread and a
+                       command queue.
 */
 
 /**
@@ -19,10 +23,12 @@
     @filename misc.h
     @author Shreyas Vinod
 
-    @brief An embarrassing file using C with code by Oliver Brausch,
-           to check for input waiting.
+    @brief Handles standard input for the UCI protocol.
 
-    @see http://home.arcor.de/dreamlike/chess/.
+    A single reader thread reads standard input line by line into a
+    lock-free single-producer, single-consumer command queue, which the UCI
+    loop and the search both consume. Standard input is never read from
+    anywhere else, so no command is ever lost to another reader's buffer.
 */
 
 #ifndef MISC_H
@@ -30,11 +36,28 @@
 
 #include "defs.h"
 
+#include <string> // std::string
+
 #include "search.h"
 
+#define INPUT_QUEUE_SIZE 256 // Must be a power of two.
+
 // External function declarations
 
-extern bool input_waiting();
+// Start the thread reading standard input into the command queue.
+
+extern void start_input();
+
+// Take the next command off the queue, optionally waiting for one.
+
+extern bool next_input(std::string& line, bool wait);
+
+// Look at a command on the queue without taking it off.
+
+extern bool peek_input(std::string& line, unsigned int ahead);
+
+// Handle commands that arrive during a search.
+
 extern void read_input(SearchInfo& search_info);
 
 #endif // MISC_H
\ No newline at end of file
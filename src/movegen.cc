@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename movegen.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.4
 
     @brief Generates moves given a board position.
 
@@ -15,6 +15,12 @@
     * 29/11/2015 0.1.1 Added functions to generate just captures.
     * 05/12/2015 0.1.2 Added functions to generate legal moves and captures.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added is_pseudo_legal(const Board&, unsigned int).
+    * 17/10/2026 1.0.2 is_pseudo_legal() now uses BETWEEN_BB().
+    * 17/10/2026 1.0.3 Replaced per-piece generators with one templated generator.
+        * Added attackers_to(), gen_quiets(), gen_evasions() and gen_quiet_checks().
+        * is_sq_attacked() now uses the slider attack helpers.
+    * 17/10/2026 1.0.4 Pawn moves are now generated set-wise.
 */
 
 /**
@@ -45,35 +51,56 @@ const int VICTIM_SCORE[12] = {100, 400, 300, 200, 500, 600,
     100, 400, 300, 200, 500, 600};
 unsigned int MVV_LVA_ST[12][12]; // MVV-LVA scores lookup table.
 
+// Enumerations
+
+/*
+    The kinds of move lists the generator can produce. GEN_CAPTURES holds
+    captures, capture promotions and en passant. GEN_QUIETS holds every other
+    move, including quiet promotions and castling. GEN_EVASIONS holds a
+    superset of the legal replies to check. GEN_QUIET_CHECKS holds the quiet
+    moves, bar promotions and castling, that give direct check. GEN_ALL holds
+    every pseudo-legal move.
+*/
+
+enum GenType { GEN_CAPTURES, GEN_QUIETS, GEN_EVASIONS, GEN_QUIET_CHECKS,
+    GEN_ALL };
+
 // Prototypes
 
 void init_mvv_lva();
 std::string pretty_move_list(const std::vector<Move>& list);
 inline void push_quiet_move(MoveList& ml, unsigned int move,
-    const Board& board);
+    unsigned int piece, const Board& board);
 inline void push_capture_move(MoveList& ml, unsigned int move,
-    const Board& board);
+    unsigned int piece);
 inline void push_enp_capture_move(MoveList& ml, unsigned int move);
 inline void push_castling_move(MoveList& ml, unsigned int move);
-void gen_rook_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-void gen_rook_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-void gen_knight_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-void gen_knight_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-void gen_bishop_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-void gen_bishop_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-void gen_pawn_moves(bool gen_side, MoveList& ml, const Board& board);
-void gen_pawn_cap_moves(bool gen_side, MoveList& ml, const Board& board);
-void gen_king_moves(bool gen_side, MoveList& ml, const Board& board);
-void gen_king_cap_moves(bool gen_side, MoveList& ml, const Board& board);
+template<Color Us> inline uint64 pawn_push_bb(uint64 bb);
+template<Color Us> inline uint64 pawn_west_bb(uint64 bb);
+template<Color Us> inline uint64 pawn_east_bb(uint64 bb);
+template<Color Us> inline uint64 pawn_attacks_bb(uint64 bb);
+template<unsigned int Pt> inline uint64 piece_attacks_bb(unsigned int index,
+    uint64 occ);
+template<Color Us, GenType T, unsigned int Pt>
+inline void gen_piece_moves(const Board& board, MoveList& ml, uint64 target,
+    uint64 occ);
+template<Color Us, bool Capture>
+inline void push_promotions(MoveList& ml, unsigned int dep_cell,
+    unsigned int dst_cell, unsigned int captured, const Board& board);
+template<Color Us, GenType T>
+inline void gen_pawn_moves(const Board& board, MoveList& ml, uint64 target);
+template<Color Us, GenType T>
+inline void gen_king_moves(const Board& board, MoveList& ml, unsigned int ksq,
+    uint64 target);
+template<Color Us, GenType T> void generate(const Board& board, MoveList& ml);
+uint64 attackers_to(const Board& board, unsigned int index, uint64 occ);
 bool is_sq_attacked(unsigned int index, bool gen_side, const Board& board);
+bool is_pseudo_legal(const Board& board, unsigned int move);
 MoveList gen_moves(const Board& board);
 MoveList gen_captures(const Board& board);
+MoveList gen_quiets(const Board& board);
+MoveList gen_evasions(const Board& board);
+MoveList gen_quiet_checks(const Board& board);
 MoveList gen_legal_moves(Board& board);
 MoveList gen_legal_captures(Board& board);
 
@@ -160,13 +187,14 @@ std::string pretty_move_list(const std::vector<Move>& list)
 
     @param list is the move list structure.
     @param move is an integer value representing a move.
+    @param piece is the type of the piece being moved.
     @param board is the board the move is being made on.
 
     @return void.
 */
 
 inline void push_quiet_move(MoveList& ml, unsigned int move,
-    const Board& board)
+    unsigned int piece, const Board& board)
 {
     if(board.search_killers[0][board.ply] == move)
     {
@@ -180,12 +208,9 @@ inline void push_quiet_move(MoveList& ml, unsigned int move,
     }
     else
     {
-        assert((GET_BB(DEP_CELL(move)) != 0ULL) &&
-            ((GET_BB(DEP_CELL(move)) &
-            (GET_BB(DEP_CELL(move)) - 1)) == 0ULL));
+        assert(piece == determine_type(board, GET_BB(DEP_CELL(move))));
 
-        Move move_push(move, board.search_history[determine_type(board,
-            GET_BB(DEP_CELL(move)))][DST_CELL(move)]);
+        Move move_push(move, board.search_history[piece][DST_CELL(move)]);
         ml.list.push_back(move_push);
     }
 }
@@ -195,13 +220,13 @@ inline void push_quiet_move(MoveList& ml, unsigned int move,
 
     @param list is the move list structure.
     @param move is an integer value representing the move.
-    @param board is the board the move is being made on.
+    @param piece is the type of the piece making the capture.
 
     @return void.
 */
 
 inline void push_capture_move(MoveList& ml, unsigned int move,
-    const Board& board)
+    unsigned int piece)
 {
     unsigned int cap_type = CAPTURED(move);
 
@@ -210,11 +235,7 @@ inline void push_capture_move(MoveList& ml, unsigned int move,
     {
         ml.attacked |= GET_BB(DST_CELL(move));
 
-        assert((GET_BB(DEP_CELL(move)) != 0ULL) &&
-            ((GET_BB(DEP_CELL(move)) & (GET_BB(DEP_CELL(move)) - 1)) == 0ULL));
-
-        Move move_push(move, MVV_LVA_ST[cap_type][determine_type(board,
-            GET_BB(DEP_CELL(move)))] + 100000);
+        Move move_push(move, MVV_LVA_ST[cap_type][piece] + 100000);
         ml.list.push_back(move_push);
     }
 }
@@ -252,1947 +273,810 @@ inline void push_castling_move(MoveList& ml, unsigned int move)
 }
 
 /**
-    @brief Generates and pushes all pseudo-legal rook moves into the move
-           list vector for the given board state.
-
-    This function generates all pseudo-legal moves for a given bitboard,
-    considering all set bits as rooks. This is also useful for generating
-    line moves for queens.
+    @brief Shifts the given pawns of side 'Us' one cell forward.
 
-    @param u64_1 is the bitboard representing all pieces which are to be
-           considered as rooks during generation.
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
+    @param bb is the bitboard of pawns.
 
-    @return void.
+    @return uint64 bitboard of the cells in front of the pawns.
 */
 
-void gen_rook_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board)
+template<Color Us> inline uint64 pawn_push_bb(uint64 bb)
 {
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
+    return Us == WHITE ? bb << 8 : bb >> 8;
+}
 
-    const uint64 OCC = white_bb | black_bb; // Occupied bitboard.
+/**
+    @brief Shifts the given pawns of side 'Us' diagonally forward, towards
+           the A file.
 
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_2, u64_3; // Temporary variables.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
+    @param bb is the bitboard of pawns.
 
-    // Generation
+    @return uint64 bitboard of the cells the pawns attack towards the A file.
+*/
 
-    bit_cnt = CNT_BITS(u64_1);
+template<Color Us> inline uint64 pawn_west_bb(uint64 bb)
+{
+    return (Us == WHITE ? bb << 7 : bb >> 9) & ~B_FILE[FILE_H];
+}
 
-    for(unsigned int i = 0; i < bit_cnt; i++)
-    {
-        uint_1 = POP_BIT(u64_1);
+/**
+    @brief Shifts the given pawns of side 'Us' diagonally forward, towards
+           the H file.
 
-        // North
+    @param bb is the bitboard of pawns.
 
-        u64_2 = LINE_N_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    @return uint64 bitboard of the cells the pawns attack towards the H file.
+*/
 
-        u64_2 = (u64_2 << 8) | (u64_2 << 16) | (u64_2 << 24) |
-            (u64_2 << 32) | (u64_2 << 40) | (u64_2 << 48);
-        u64_2 &= LINE_N_LT[uint_1];
-        u64_2 ^= LINE_N_LT[uint_1];
+template<Color Us> inline uint64 pawn_east_bb(uint64 bb)
+{
+    return (Us == WHITE ? bb << 9 : bb >> 7) & ~B_FILE[FILE_A];
+}
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+/**
+    @brief Returns the cells attacked by the given pawns of side 'Us'.
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-        {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+    @param bb is the bitboard of pawns.
 
-        // Pop the capture move last.
+    @return uint64 bitboard of the cells the pawns attack.
+*/
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
-        {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
-        }
+template<Color Us> inline uint64 pawn_attacks_bb(uint64 bb)
+{
+    return pawn_west_bb<Us>(bb) | pawn_east_bb<Us>(bb);
+}
 
-        // South
+/**
+    @brief Returns the cells attacked by a piece of type 'Pt' on the given
+           cell.
 
-        u64_2 = LINE_S_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    'Pt' is given as the white piece type (wN, wB, wR, wQ or wK), and selects
+    the lookup at compile time.
 
-        u64_2 = (u64_2 >> 8) | (u64_2 >> 16) | (u64_2 >> 24) |
-            (u64_2 >> 32) | (u64_2 >> 40) | (u64_2 >> 48);
-        u64_2 &= LINE_S_LT[uint_1];
-        u64_2 ^= LINE_S_LT[uint_1];
+    @param index is the index of the piece's cell in LERF layout.
+    @param occ is the bitboard of all occupied cells.
 
-        if(u64_3) // Pop the capture move first.
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+    @return uint64 bitboard of the attacked cells.
+*/
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
-            }
-        }
-        else uint_2 = CNT_BITS(u64_2);
+template<unsigned int Pt> inline uint64 piece_attacks_bb(unsigned int index,
+    uint64 occ)
+{
+    switch(Pt)
+    {
+        case wN: return KNIGHT_LT[index];
+        case wB: return DIAG_ATTACKS_BB(index, occ);
+        case wR: return LINE_ATTACKS_BB(index, occ);
+        case wQ: return DIAG_ATTACKS_BB(index, occ) |
+            LINE_ATTACKS_BB(index, occ);
+        case wK: return KING_LT[index];
+        default: return 0ULL;
+    }
+}
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-        {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+/**
+    @brief Generates and pushes the pseudo-legal moves of every piece of
+           type 'Pt' belonging to side 'Us' that land on 'target'.
 
-        // East
+    @param board is the board on which the moves are to be generated.
+    @param ml is the move list structure to which the generated moves are
+           to be pushed.
+    @param target is the bitboard of cells the pieces may move to.
+    @param occ is the bitboard of all occupied cells.
 
-        u64_2 = LINE_E_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    @return void.
 
-        u64_2 = (u64_2 << 1) | (u64_2 << 2) | (u64_2 << 3) |
-            (u64_2 << 4) | (u64_2 << 5) | (u64_2 << 6);
-        u64_2 &= LINE_E_LT[uint_1];
-        u64_2 ^= LINE_E_LT[uint_1];
+    @warning 'target' must not contain cells occupied by side 'Us', or
+             either king.
+*/
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+template<Color Us, GenType T, unsigned int Pt>
+inline void gen_piece_moves(const Board& board, MoveList& ml, uint64 target,
+    uint64 occ)
+{
+    const unsigned int piece = Us == WHITE ? Pt : Pt + bP;
+    const uint64 enemy_bb = board.chessboard[Us == WHITE ? ALL_BLACK :
+        ALL_WHITE];
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-        {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+    uint64 pieces = board.chessboard[piece];
 
-        // Pop the capture move last.
+    while(pieces)
+    {
+        const unsigned int dep_cell = POP_BIT(pieces);
+        uint64 moves = piece_attacks_bb<Pt>(dep_cell, occ) & target;
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
+        while(moves)
         {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
+            const unsigned int dst_cell = POP_BIT(moves);
+            const uint64 dst_bb = GET_BB(dst_cell);
+
+            if(T == GEN_CAPTURES || (T != GEN_QUIETS &&
+                T != GEN_QUIET_CHECKS && (dst_bb & enemy_bb)))
+            {
+                push_capture_move(ml, GET_MOVE(dep_cell, dst_cell,
+                    determine_type(board, dst_bb), EMPTY, 0), piece);
+            }
+            else
+            {
+                push_quiet_move(ml, GET_MOVE(dep_cell, dst_cell, EMPTY, EMPTY,
+                    0), piece, board);
+            }
         }
+    }
+}
 
-        // West
+/**
+    @brief Pushes the four promotions of a pawn of side 'Us' to the move list
+           vector, as captures if 'Capture' is set.
 
-        u64_2 = LINE_W_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    @param ml is the move list structure.
+    @param dep_cell is the index of the pawn's cell in LERF layout.
+    @param dst_cell is the index of the promotion cell in LERF layout.
+    @param captured is the type of the captured piece, or EMPTY.
+    @param board is the board the moves are being made on.
 
-        u64_2 = (u64_2 >> 1) | (u64_2 >> 2) | (u64_2 >> 3) |
-            (u64_2 >> 4) | (u64_2 >> 5) | (u64_2 >> 6);
-        u64_2 &= LINE_W_LT[uint_1];
-        u64_2 ^= LINE_W_LT[uint_1];
+    @return void.
+*/
 
-        if(u64_3) // Pop the capture move first.
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+template<Color Us, bool Capture>
+inline void push_promotions(MoveList& ml, unsigned int dep_cell,
+    unsigned int dst_cell, unsigned int captured, const Board& board)
+{
+    const unsigned int pawn = Us == WHITE ? wP : bP;
+    const unsigned int promoted[4] = {pawn + wB, pawn + wR, pawn + wN,
+        pawn + wQ};
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
-            }
-        }
-        else uint_2 = CNT_BITS(u64_2);
+    for(unsigned int i = 0; i < 4; i++)
+    {
+        unsigned int move = GET_MOVE(dep_cell, dst_cell, captured,
+            promoted[i], 0);
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-        {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+        if(Capture) push_capture_move(ml, move, pawn);
+        else push_quiet_move(ml, move, pawn, board);
     }
 }
 
 /**
-    @brief Generates and pushes all pseudo-legal rook capture moves into the
-           move list vector for the given board state.
+    @brief Generates and pushes the pseudo-legal pawn moves of side 'Us'.
 
-    This function generates all pseudo-legal captures moves for a given.
-    bitboard, considering all set bits as rooks. This is also useful for
-    generating line capture moves for queens.
+    Moves are generated set-wise. The whole pawn bitboard is shifted once for
+    single pushes, double pushes and each capture direction, and masked with
+    the empty, enemy and promotion cells, so that only the destination cells
+    are serialised. Pushes must land on an empty cell in 'target', and
+    captures on an enemy piece in 'target'. En passant is generated whenever
+    it is available, since the captured pawn need not be on 'target' to
+    answer a check.
 
-    @param u64_1 is the bitboard representing all pieces which are to be
-           considered as rooks during generation.
-    @param gen_side is the side to generate moves for.
+    @param board is the board on which the moves are to be generated.
     @param ml is the move list structure to which the generated moves are
            to be pushed.
-    @param board is the board on which the moves are to be generated.
+    @param target is the bitboard of cells the pawns may move to.
 
     @return void.
+
+    @warning Pawns shouldn't be present on the promotion ranks (1 and 8).
 */
 
-void gen_rook_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board)
+template<Color Us, GenType T>
+inline void gen_pawn_moves(const Board& board, MoveList& ml, uint64 target)
 {
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
+    const unsigned int pawn = Us == WHITE ? wP : bP;
+    const unsigned int enemy_pawn = Us == WHITE ? bP : wP;
 
-    const uint64 OCC = white_bb | black_bb; // Occupied bitboard.
+    // Cell index differences from departure to destination.
 
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_2, u64_3; // Temporary variables.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
+    const int up = Us == WHITE ? 8 : -8;
+    const int west = Us == WHITE ? 7 : -9;
+    const int east = Us == WHITE ? 9 : -7;
 
-    // Generation
+    const uint64 third_rank = B_RANK[Us == WHITE ? RANK_3 : RANK_6];
+    const uint64 seventh_rank = B_RANK[Us == WHITE ? RANK_7 : RANK_2];
 
-    bit_cnt = CNT_BITS(u64_1);
+    const uint64 enemy_bb = board.chessboard[Us == WHITE ? ALL_BLACK :
+        ALL_WHITE];
+    const uint64 free_bb = ~(board.chessboard[ALL_WHITE] |
+        board.chessboard[ALL_BLACK]);
 
-    for(unsigned int i = 0; i < bit_cnt; i++)
-    {
-        uint_1 = POP_BIT(u64_1);
+    const uint64 pawns = board.chessboard[pawn];
+    const uint64 promoting = pawns & seventh_rank;
+    const uint64 others = pawns & ~seventh_rank;
 
-        // North
+    uint64 u64_1, u64_2; // Destination cells; temporary variables.
+    unsigned int dst_cell; // Temporary variable.
 
-        u64_2 = LINE_N_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    // Single and double pushes
 
-        u64_2 = (u64_2 << 8) | (u64_2 << 16) | (u64_2 << 24) |
-            (u64_2 << 32) | (u64_2 << 40) | (u64_2 << 48);
-        u64_2 &= LINE_N_LT[uint_1];
-        u64_2 ^= LINE_N_LT[uint_1];
+    if(T != GEN_CAPTURES)
+    {
+        u64_1 = pawn_push_bb<Us>(others) & free_bb;
+        u64_2 = pawn_push_bb<Us>(u64_1 & third_rank) & free_bb & target;
+        u64_1 &= target;
 
-        if(u64_3)
+        while(u64_1)
         {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
+            dst_cell = POP_BIT(u64_1);
+            push_quiet_move(ml, GET_MOVE(dst_cell - up, dst_cell, EMPTY, EMPTY,
+                0), pawn, board);
         }
-        else uint_2 = CNT_BITS(u64_2);
 
-        for(unsigned int i = 0; i < uint_2; i++)
+        while(u64_2)
         {
-            POP_BIT(u64_2);
+            dst_cell = POP_BIT(u64_2);
+            push_quiet_move(ml, GET_MOVE(dst_cell - 2 * up, dst_cell, EMPTY,
+                EMPTY, MFLAGPS), pawn, board);
         }
+    }
 
-        // Pop the capture move last.
+    // Promotions
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
+    if(T != GEN_QUIET_CHECKS && promoting)
+    {
+        if(T != GEN_CAPTURES)
         {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
-        }
+            u64_1 = pawn_push_bb<Us>(promoting) & free_bb & target;
 
-        // South
-
-        u64_2 = LINE_S_LT[uint_1] & OCC;
-        u64_3 = u64_2;
-
-        u64_2 = (u64_2 >> 8) | (u64_2 >> 16) | (u64_2 >> 24) |
-            (u64_2 >> 32) | (u64_2 >> 40) | (u64_2 >> 48);
-        u64_2 &= LINE_S_LT[uint_1];
-        u64_2 ^= LINE_S_LT[uint_1];
+            while(u64_1)
+            {
+                dst_cell = POP_BIT(u64_1);
+                push_promotions<Us, 0>(ml, dst_cell - up, dst_cell, EMPTY,
+                    board);
+            }
+        }
 
-        if(u64_3) // Pop the capture move first.
+        if(T != GEN_QUIETS)
         {
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+            u64_1 = pawn_west_bb<Us>(promoting) & enemy_bb & target;
+            u64_2 = pawn_east_bb<Us>(promoting) & enemy_bb & target;
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
+            while(u64_1)
             {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
+                dst_cell = POP_BIT(u64_1);
+                push_promotions<Us, 1>(ml, dst_cell - west, dst_cell,
+                    determine_type(board, GET_BB(dst_cell)), board);
             }
-        }
-
-        // East
 
-        u64_2 = LINE_E_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+            while(u64_2)
+            {
+                dst_cell = POP_BIT(u64_2);
+                push_promotions<Us, 1>(ml, dst_cell - east, dst_cell,
+                    determine_type(board, GET_BB(dst_cell)), board);
+            }
+        }
+    }
 
-        u64_2 = (u64_2 << 1) | (u64_2 << 2) | (u64_2 << 3) |
-            (u64_2 << 4) | (u64_2 << 5) | (u64_2 << 6);
-        u64_2 &= LINE_E_LT[uint_1];
-        u64_2 ^= LINE_E_LT[uint_1];
+    // Captures
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+    if(T != GEN_QUIETS && T != GEN_QUIET_CHECKS)
+    {
+        u64_1 = pawn_west_bb<Us>(others) & enemy_bb & target;
+        u64_2 = pawn_east_bb<Us>(others) & enemy_bb & target;
 
-        for(unsigned int i = 0; i < uint_2; i++)
+        while(u64_1)
         {
-            POP_BIT(u64_2);
+            dst_cell = POP_BIT(u64_1);
+            push_capture_move(ml, GET_MOVE(dst_cell - west, dst_cell,
+                determine_type(board, GET_BB(dst_cell)), EMPTY, 0), pawn);
         }
 
-        // Pop the capture move last.
-
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
+        while(u64_2)
         {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
+            dst_cell = POP_BIT(u64_2);
+            push_capture_move(ml, GET_MOVE(dst_cell - east, dst_cell,
+                determine_type(board, GET_BB(dst_cell)), EMPTY, 0), pawn);
         }
 
-        // West
-
-        u64_2 = LINE_W_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+        // En passant, found by looking from the en passant cell for pawns
+        // that attack it.
 
-        u64_2 = (u64_2 >> 1) | (u64_2 >> 2) | (u64_2 >> 3) |
-            (u64_2 >> 4) | (u64_2 >> 5) | (u64_2 >> 6);
-        u64_2 &= LINE_W_LT[uint_1];
-        u64_2 ^= LINE_W_LT[uint_1];
-
-        if(u64_3) // Pop the capture move first.
+        if(board.en_pas_sq != NO_SQ)
         {
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+            u64_1 = others & pawn_attacks_bb<Us == WHITE ? BLACK : WHITE>(
+                GET_BB(board.en_pas_sq));
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
+            while(u64_1)
             {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
+                push_enp_capture_move(ml, GET_MOVE(POP_BIT(u64_1),
+                    board.en_pas_sq, enemy_pawn, EMPTY, MFLAGEP));
             }
         }
     }
 }
 
 /**
-    @brief Generates and pushes all pseudo-legal knight moves into the move
-           list vector for the given board state.
-
-    This function generates all pseudo-legal moves for a given bitboard,
-    considering all set bits as knights.
+    @brief Generates and pushes the pseudo-legal king moves of side 'Us',
+           including castling for GEN_QUIETS and GEN_ALL.
 
-    @param u64_1 is the bitboard representing all knights.
-    @param gen_side is the side to generate moves for.
+    @param board is the board on which the moves are to be generated.
     @param ml is the move list structure to which the generated moves are
            to be pushed.
-    @param board is the board on which the moves are to be generated.
+    @param ksq is the index of the king's cell in LERF layout.
+    @param target is the bitboard of cells the king may move to.
 
     @return void.
 */
 
-void gen_knight_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board)
+template<Color Us, GenType T>
+inline void gen_king_moves(const Board& board, MoveList& ml, unsigned int ksq,
+    uint64 target)
 {
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
-
-    const uint64 FREE = ~white_bb & ~black_bb; // Free bitboard.
-
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_2, u64_3; // Temporary variable.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
+    const unsigned int king_cell = Us == WHITE ? e1 : e8;
+    const unsigned int king_side = Us == WHITE ? WKCA : BKCA;
+    const unsigned int queen_side = Us == WHITE ? WQCA : BQCA;
 
-    // Generation
+    gen_piece_moves<Us, T, wK>(board, ml, target, 0ULL);
 
-    bit_cnt = CNT_BITS(u64_1);
+    // Castling
 
-    for(unsigned int i = 0; i < bit_cnt; i++)
+    if((T == GEN_QUIETS || T == GEN_ALL) && ksq == king_cell &&
+        (board.castle_perm & (king_side | queen_side)))
     {
-        uint_1 = POP_BIT(u64_1);
-
-        // Captures
+        const uint64 occ = board.chessboard[ALL_WHITE] |
+            board.chessboard[ALL_BLACK];
 
-        if(gen_side == WHITE) u64_2 = KNIGHT_LT[uint_1] & black_bb;
-        else u64_2 = KNIGHT_LT[uint_1] & white_bb;
+        if(is_sq_attacked(king_cell, Us, board)) return;
 
-        uint_2 = CNT_BITS(u64_2);
-
-        for(unsigned int i = 0; i < uint_2; i++) // Push capture moves.
+        if((board.castle_perm & king_side) &&
+            !(occ & (GET_BB(king_cell + 1) | GET_BB(king_cell + 2))) &&
+            !is_sq_attacked(king_cell + 1, Us, board))
         {
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                determine_type(board, u64_3), EMPTY, 0), board);
+            push_castling_move(ml, GET_MOVE(king_cell, king_cell + 2, EMPTY,
+                EMPTY, MFLAGCA));
         }
 
-        u64_2 = KNIGHT_LT[uint_1] & FREE;
-
-        uint_2 = CNT_BITS(u64_2);
-
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
+        if((board.castle_perm & queen_side) &&
+            !(occ & (GET_BB(king_cell - 1) | GET_BB(king_cell - 2) |
+            GET_BB(king_cell - 3))) &&
+            !is_sq_attacked(king_cell - 1, Us, board))
         {
-            push_quiet_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                EMPTY, EMPTY, 0), board);
+            push_castling_move(ml, GET_MOVE(king_cell, king_cell - 2, EMPTY,
+                EMPTY, MFLAGCA));
         }
     }
 }
 
 /**
-    @brief Generates and pushes all pseudo-legal knight capture moves into the
-           move list vector for the given board state.
+    @brief Generates and pushes the pseudo-legal moves of type 'T' for side
+           'Us' into the move list vector.
 
-    This function generates all pseudo-legal capture moves for a given
-    bitboard, considering all set bits as knights.
+    The side and the generation type are template parameters, so that the
+    directions, piece types and targets fold to constants and every
+    instantiation runs without colour branches.
 
-    @param u64_1 is the bitboard representing all knights.
-    @param gen_side is the side to generate moves for.
+    @param board is the board on which the moves are to be generated.
     @param ml is the move list structure to which the generated moves are
            to be pushed.
-    @param board is the board on which the moves are to be generated.
 
     @return void.
+
+    @warning There must be exactly ONE king for each side.
+    @warning GEN_EVASIONS must only be used when side 'Us' is in check.
 */
 
-void gen_knight_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board)
+template<Color Us, GenType T> void generate(const Board& board, MoveList& ml)
 {
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
+    const uint64 own_bb = board.chessboard[Us == WHITE ? ALL_WHITE :
+        ALL_BLACK];
+    const uint64 enemy_bb = board.chessboard[Us == WHITE ? ALL_BLACK :
+        ALL_WHITE];
+    const uint64 occ = own_bb | enemy_bb;
 
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_2, u64_3; // Temporary variable.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
+    // Kings are never captured, so their cells are never targets.
 
-    // Generation
+    const uint64 kings = board.chessboard[wK] | board.chessboard[bK];
 
-    bit_cnt = CNT_BITS(u64_1);
+    uint64 king_bb = board.chessboard[Us == WHITE ? wK : bK];
 
-    for(unsigned int i = 0; i < bit_cnt; i++)
+    assert((king_bb != 0ULL) && ((king_bb & (king_bb - 1)) == 0ULL));
+
+    const unsigned int ksq = POP_BIT(king_bb);
+
+    uint64 target;
+
+    switch(T)
     {
-        uint_1 = POP_BIT(u64_1);
+        case GEN_CAPTURES: target = enemy_bb & ~kings; break;
+        case GEN_QUIETS: case GEN_QUIET_CHECKS: target = ~occ; break;
+        case GEN_EVASIONS: case GEN_ALL: default: target = ~own_bb & ~kings;
+    }
 
-        // Captures
+    if(T == GEN_EVASIONS)
+    {
+        uint64 checkers = attackers_to(board, ksq, occ) & enemy_bb;
 
-        if(gen_side == WHITE) u64_2 = KNIGHT_LT[uint_1] & black_bb;
-        else u64_2 = KNIGHT_LT[uint_1] & white_bb;
+        assert(checkers);
 
-        uint_2 = CNT_BITS(u64_2);
+        // Only the king can answer a double check. Otherwise, the other
+        // pieces must capture the checker or block its line.
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push capture moves.
+        if(checkers & (checkers - 1))
         {
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                determine_type(board, u64_3), EMPTY, 0), board);
+            gen_king_moves<Us, T>(board, ml, ksq, target);
+            return;
         }
+
+        const unsigned int checker = POP_BIT(checkers);
+
+        target = GET_BB(checker) | BETWEEN_BB(ksq, checker);
+    }
+
+    // For quiet checks, each piece may only move to the cells from which it
+    // would attack the enemy king.
+
+    uint64 knight_target = target, diag_target = target, line_target = target,
+        pawn_target = target;
+
+    if(T == GEN_QUIET_CHECKS)
+    {
+        uint64 enemy_king_bb = board.chessboard[Us == WHITE ? bK : wK];
+        const unsigned int enemy_ksq = POP_BIT(enemy_king_bb);
+
+        knight_target &= KNIGHT_LT[enemy_ksq];
+        diag_target &= DIAG_ATTACKS_BB(enemy_ksq, occ);
+        line_target &= LINE_ATTACKS_BB(enemy_ksq, occ);
+        pawn_target &= pawn_attacks_bb<Us == WHITE ? BLACK : WHITE>(
+            board.chessboard[Us == WHITE ? bK : wK]);
     }
+
+    gen_piece_moves<Us, T, wQ>(board, ml, diag_target | line_target, occ);
+    gen_piece_moves<Us, T, wR>(board, ml, line_target, occ);
+    gen_piece_moves<Us, T, wN>(board, ml, knight_target, occ);
+    gen_piece_moves<Us, T, wB>(board, ml, diag_target, occ);
+    gen_pawn_moves<Us, T>(board, ml, pawn_target);
+
+    if(T == GEN_EVASIONS) target = ~own_bb & ~kings;
+    if(T != GEN_QUIET_CHECKS) gen_king_moves<Us, T>(board, ml, ksq, target);
 }
 
 /**
-    @brief Generates and pushes all pseudo-legal bishop moves into the move
-           list vector for the given board state.
+    @brief Returns every piece, of either side, that attacks the given cell.
 
-    This function generates all pseudo-legal moves for a given bitboard,
-    considering all set bits as bishops. This is also useful for generating
-    diagonal moves for queens.
+    @param board is the board to check on.
+    @param index is the integer index of the cell in LERF layout.
+    @param occ is the bitboard of occupied cells to use for sliding pieces.
 
-    @param u64_1 is the bitboard representing all pieces which are to be
-           considered as bishops during generation.
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
+    @return uint64 bitboard of the attacking pieces.
 
-    @return void.
+    @warning 'index' must be between (or equal to) 0 and 63.
 */
 
-void gen_bishop_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board)
+uint64 attackers_to(const Board& board, unsigned int index, uint64 occ)
 {
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
+    const uint64 bb = GET_BB(index);
+    const uint64 queens = board.chessboard[wQ] | board.chessboard[bQ];
+
+    return (pawn_attacks_bb<WHITE>(bb) & board.chessboard[bP]) |
+        (pawn_attacks_bb<BLACK>(bb) & board.chessboard[wP]) |
+        (KNIGHT_LT[index] & (board.chessboard[wN] | board.chessboard[bN])) |
+        (KING_LT[index] & (board.chessboard[wK] | board.chessboard[bK])) |
+        (DIAG_ATTACKS_BB(index, occ) &
+        (board.chessboard[wB] | board.chessboard[bB] | queens)) |
+        (LINE_ATTACKS_BB(index, occ) &
+        (board.chessboard[wR] | board.chessboard[bR] | queens));
+}
 
-    const uint64 OCC = white_bb | black_bb; // Occupied bitboard.
+/**
+    @brief Determines whether the given cell index is under attack.
 
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_2, u64_3; // Temporary variables.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
+    Pawns, knights and kings are found with a single lookup each. Sliders are
+    only scanned for when a rook, bishop or queen of the opposite side shares
+    a line or a diagonal with the cell.
 
-    // Generation
+    @param index is the integer index of the cell to check in LERF layout.
+    @param gen_side is the side to be considered when checking whether the cell
+           indexed by 'index' is attacked. It represents the defender.
+    @param board is the board to check on.
 
-    bit_cnt = CNT_BITS(u64_1);
+    @return bool denoting whether the cell indexed by 'index' is under attack
+            by the opposite side (opposite to 'gen_side').
 
-    for(unsigned int i = 0; i < bit_cnt; i++)
-    {
-        uint_1 = POP_BIT(u64_1);
+    @warning 'index' must be between (or equal to) 0 and 63.
+    @warning 'index' must be in LERF layout.
+*/
 
-        // Northeast
+bool is_sq_attacked(unsigned int index, bool gen_side, const Board& board)
+{
+    const unsigned int them = gen_side == WHITE ? bP : wP; // Attacker's pawn.
+    const uint64 bb = GET_BB(index);
 
-        u64_2 = DIAG_NE_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    const uint64 pawn_attacks = gen_side == WHITE ?
+        pawn_attacks_bb<WHITE>(bb) : pawn_attacks_bb<BLACK>(bb);
 
-        u64_2 = (u64_2 << 9) | (u64_2 << 18) | (u64_2 << 27) |
-            (u64_2 << 36) | (u64_2 << 45) | (u64_2 << 54);
-        u64_2 &= DIAG_NE_LT[uint_1];
-        u64_2 ^= DIAG_NE_LT[uint_1];
+    if(pawn_attacks & board.chessboard[them + wP]) return 1;
+    if(KNIGHT_LT[index] & board.chessboard[them + wN]) return 1;
+    if(KING_LT[index] & board.chessboard[them + wK]) return 1;
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+    const uint64 occ = board.chessboard[ALL_WHITE] |
+        board.chessboard[ALL_BLACK];
+    const uint64 lines = board.chessboard[them + wR] |
+        board.chessboard[them + wQ];
+    const uint64 diags = board.chessboard[them + wB] |
+        board.chessboard[them + wQ];
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-        {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+    if((LINE_LT[index] & lines) && (LINE_ATTACKS_BB(index, occ) & lines))
+        return 1;
+    if((DIAG_LT[index] & diags) && (DIAG_ATTACKS_BB(index, occ) & diags))
+        return 1;
 
-        // Pop the capture move last.
+    return 0;
+}
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
-        {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
-        }
+/**
+    @brief Checks whether a move could have been generated by gen_moves() for
+           the given board state, without generating any moves.
 
-        // Northwest
+    Validates the departure piece, the captured piece, the flags and the
+    geometry of the move with bitboard tests alone, so that hash, killer and
+    PV moves can be verified in constant time before they are made.
 
-        u64_2 = DIAG_NW_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    @param board is the board to check on.
+    @param move is the integer representation of the move to check in
+           standard convention.
 
-        u64_2 = (u64_2 << 7) | (u64_2 << 14) | (u64_2 << 21) |
-            (u64_2 << 28) | (u64_2 << 35) | (u64_2 << 42);
-        u64_2 &= DIAG_NW_LT[uint_1];
-        u64_2 ^= DIAG_NW_LT[uint_1];
+    @return bool denoting whether 'move' is pseudo-legal on 'board', in the
+            exact encoding move generation would produce.
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+    @warning The move may still leave the king in check. Use make_move() to
+             check for full legality.
+*/
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-        {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+bool is_pseudo_legal(const Board& board, unsigned int move)
+{
+    if(move == NO_MOVE || (move >> 23)) return 0; // Unused bits are set.
 
-        // Pop the capture move last.
+    const bool side = board.side;
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
-        {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
-        }
+    const unsigned int dep_cell = DEP_CELL(move);
+    const unsigned int dst_cell = DST_CELL(move);
+    const unsigned int captured = CAPTURED(move);
+    const unsigned int promoted = PROMOTED(move);
+
+    const uint64 dep_bb = GET_BB(dep_cell);
+    const uint64 dst_bb = GET_BB(dst_cell);
+    const uint64 own_bb = board.chessboard[side == WHITE ? ALL_WHITE :
+        ALL_BLACK];
+    const uint64 enemy_bb = board.chessboard[side == WHITE ? ALL_BLACK :
+        ALL_WHITE];
+    const uint64 occ = own_bb | enemy_bb;
 
-        // Southeast
+    if(!(dep_bb & own_bb) || (dst_bb & own_bb)) return 0;
+    if(captured == wK || captured == bK) return 0; // Never generated.
 
-        u64_2 = DIAG_SE_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    const unsigned int piece = determine_type(board, dep_bb);
 
-        u64_2 = (u64_2 >> 7) | (u64_2 >> 14) | (u64_2 >> 21) |
-            (u64_2 >> 28) | (u64_2 >> 35) | (u64_2 >> 42);
-        u64_2 &= DIAG_SE_LT[uint_1];
-        u64_2 ^= DIAG_SE_LT[uint_1];
+    // Castling, with the same conditions as move generation.
 
-        if(u64_3) // Pop the capture move first.
+    if(IS_CAS(move))
+    {
+        if(side == WHITE && piece == wK)
         {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+            if(move == GET_MOVE(e1, g1, EMPTY, EMPTY, MFLAGCA))
+            {
+                return (board.castle_perm & WKCA) &&
+                    !(occ & (GET_BB(f1) | GET_BB(g1))) &&
+                    !is_sq_attacked(e1, WHITE, board) &&
+                    !is_sq_attacked(f1, WHITE, board);
+            }
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
+            if(move == GET_MOVE(e1, c1, EMPTY, EMPTY, MFLAGCA))
             {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
+                return (board.castle_perm & WQCA) &&
+                    !(occ & (GET_BB(d1) | GET_BB(c1) | GET_BB(b1))) &&
+                    !is_sq_attacked(e1, WHITE, board) &&
+                    !is_sq_attacked(d1, WHITE, board);
             }
         }
-        else uint_2 = CNT_BITS(u64_2);
-
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
+        else if(side == BLACK && piece == bK)
         {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
-        }
+            if(move == GET_MOVE(e8, g8, EMPTY, EMPTY, MFLAGCA))
+            {
+                return (board.castle_perm & BKCA) &&
+                    !(occ & (GET_BB(f8) | GET_BB(g8))) &&
+                    !is_sq_attacked(e8, BLACK, board) &&
+                    !is_sq_attacked(f8, BLACK, board);
+            }
 
-        // Southwest
+            if(move == GET_MOVE(e8, c8, EMPTY, EMPTY, MFLAGCA))
+            {
+                return (board.castle_perm & BQCA) &&
+                    !(occ & (GET_BB(d8) | GET_BB(c8) | GET_BB(b8))) &&
+                    !is_sq_attacked(e8, BLACK, board) &&
+                    !is_sq_attacked(d8, BLACK, board);
+            }
+        }
 
-        u64_2 = DIAG_SW_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+        return 0;
+    }
 
-        u64_2 = (u64_2 >> 9) | (u64_2 >> 18) | (u64_2 >> 27) |
-            (u64_2 >> 36) | (u64_2 >> 45) | (u64_2 >> 54);
-        u64_2 &= DIAG_SW_LT[uint_1];
-        u64_2 ^= DIAG_SW_LT[uint_1];
+    // Pawns.
 
-        if(u64_3) // Pop the capture move first.
+    if(piece == wP || piece == bP)
+    {
+        const uint64 attacks = side == WHITE ?
+            ((dep_bb << 7) & ~B_FILE[FILE_H]) |
+            ((dep_bb << 9) & ~B_FILE[FILE_A]) :
+            ((dep_bb >> 7) & ~B_FILE[FILE_A]) |
+            ((dep_bb >> 9) & ~B_FILE[FILE_H]);
+        const unsigned int forward = side == WHITE ? dep_cell + 8 :
+            dep_cell - 8;
+        const uint64 last_rank = B_RANK[side == WHITE ? RANK_8 : RANK_1];
+
+        if(IS_ENPAS_CAP(move))
         {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+            return dst_cell == board.en_pas_sq && (attacks & dst_bb) &&
+                captured == (side == WHITE ? bP : wP) && promoted == EMPTY &&
+                !IS_PSTR(move);
+        }
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
-            }
+        // Promotions must be to a piece of the side to move, and only
+        // happen on the last rank.
+
+        if(dst_bb & last_rank)
+        {
+            if(side == WHITE && promoted != wB && promoted != wR &&
+                promoted != wN && promoted != wQ)
+                return 0;
+            if(side == BLACK && promoted != bB && promoted != bR &&
+                promoted != bN && promoted != bQ)
+                return 0;
         }
-        else uint_2 = CNT_BITS(u64_2);
+        else if(promoted != EMPTY) return 0;
 
-        for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
+        if(dst_bb & enemy_bb) // Captures.
         {
-            push_quiet_move(ml,
-                GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, 0), board);
+            return (attacks & dst_bb) && !IS_PSTR(move) &&
+                captured == determine_type(board, dst_bb);
         }
-    }
-}
 
-/**
-    @brief Generates and pushes all pseudo-legal bishop capture moves into the
-           move list vector for the given board state.
+        if(captured != EMPTY) return 0;
 
-    This function generates all pseudo-legal capture moves for a given
-    bitboard, considering all set bits as bishops. This is also useful for
-    generating diagonal capture moves for queens.
+        if(dst_cell == forward) return !IS_PSTR(move); // Single push.
 
-    @param u64_1 is the bitboard representing all pieces which are to be
-           considered as bishops during generation.
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
+        // Double push.
 
-    @return void.
-*/
+        return IS_PSTR(move) &&
+            (dep_bb & B_RANK[side == WHITE ? RANK_2 : RANK_7]) &&
+            dst_cell == (side == WHITE ? forward + 8 : forward - 8) &&
+            !(occ & GET_BB(forward));
+    }
 
-void gen_bishop_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board)
-{
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
+    // Pieces. Only pawns have flags or promote, and the captured piece must
+    // be the one on the destination cell.
 
-    const uint64 OCC = white_bb | black_bb; // Occupied bitboard.
+    if((move & (MFLAGEP | MFLAGPS)) || promoted != EMPTY) return 0;
 
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_2, u64_3; // Temporary variables.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
+    if(dst_bb & enemy_bb)
+    {
+        if(captured != determine_type(board, dst_bb)) return 0;
+    }
+    else if(captured != EMPTY) return 0;
 
-    // Generation
+    switch(piece)
+    {
+        case wN: case bN:
+            return (KNIGHT_LT[dep_cell] & dst_bb) != 0ULL;
+        case wK: case bK:
+            return (KING_LT[dep_cell] & dst_bb) != 0ULL;
+        case wR: case bR:
+            return (LINE_LT[dep_cell] & dst_bb) &&
+                !(BETWEEN_BB(dep_cell, dst_cell) & occ);
+        case wB: case bB:
+            return (DIAG_LT[dep_cell] & dst_bb) &&
+                !(BETWEEN_BB(dep_cell, dst_cell) & occ);
+        case wQ: case bQ:
+            return (LINE_DIAG_LT[dep_cell] & dst_bb) &&
+                !(BETWEEN_BB(dep_cell, dst_cell) & occ);
+        default:
+            return 0;
+    }
+}
 
-    bit_cnt = CNT_BITS(u64_1);
+/**
+    @brief Generates and returns a move list vector of all the possible
+           pseudo-legal moves for the given board state.
 
-    for(unsigned int i = 0; i < bit_cnt; i++)
-    {
-        uint_1 = POP_BIT(u64_1);
+    @param board is the board to generate all pseudo-legal moves for.
 
-        // Northeast
+    @return MoveList representing a collection of all pseudo-legal
+            moves for the given board state.
+*/
 
-        u64_2 = DIAG_NE_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+MoveList gen_moves(const Board& board)
+{
+    MoveList ml; // Move list structure.
 
-        u64_2 = (u64_2 << 9) | (u64_2 << 18) | (u64_2 << 27) |
-            (u64_2 << 36) | (u64_2 << 45) | (u64_2 << 54);
-        u64_2 &= DIAG_NE_LT[uint_1];
-        u64_2 ^= DIAG_NE_LT[uint_1];
+    if(board.side == WHITE) generate<WHITE, GEN_ALL>(board, ml);
+    else generate<BLACK, GEN_ALL>(board, ml);
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+    return ml;
+}
 
-        for(unsigned int i = 0; i < uint_2; i++)
-        {
-            POP_BIT(u64_2);
-        }
+/**
+    @brief Generates and returns a move list vector of all the possible
+           pseudo-legal capture moves for the given board state.
 
-        // Pop the capture move last.
+    @param board is the board to generate all pseudo-legal capture moves for.
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
-        {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
-        }
+    @return MoveList representing a collection of all pseudo-legal
+            capture moves for the given board state.
+*/
 
-        // Northwest
+MoveList gen_captures(const Board& board)
+{
+    MoveList ml; // Move list structure.
 
-        u64_2 = DIAG_NW_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    if(board.side == WHITE) generate<WHITE, GEN_CAPTURES>(board, ml);
+    else generate<BLACK, GEN_CAPTURES>(board, ml);
 
-        u64_2 = (u64_2 << 7) | (u64_2 << 14) | (u64_2 << 21) |
-            (u64_2 << 28) | (u64_2 << 35) | (u64_2 << 42);
-        u64_2 &= DIAG_NW_LT[uint_1];
-        u64_2 ^= DIAG_NW_LT[uint_1];
+    return ml;
+}
 
-        if(u64_3)
-        {
-            uint_2 = CNT_BITS(u64_2);
-            uint_2--;
-        }
-        else uint_2 = CNT_BITS(u64_2);
+/**
+    @brief Generates and returns a move list vector of all the possible
+           pseudo-legal non-capture moves for the given board state.
 
-        for(unsigned int i = 0; i < uint_2; i++)
-        {
-            POP_BIT(u64_2);
-        }
+    Together with gen_captures(), this covers exactly the moves of
+    gen_moves(). Quiet promotions and castling are included.
 
-        // Pop the capture move last.
+    @param board is the board to generate all pseudo-legal quiet moves for.
 
-        if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-            (gen_side == BLACK && (u64_2 & white_bb))))
-        {
-            u64_3 = u64_2;
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            push_capture_move(ml, GET_MOVE(uint_1, POP_BIT(u64_2),
-                determine_type(board, u64_3), EMPTY, 0), board);
-        }
+    @return MoveList representing a collection of all pseudo-legal
+            quiet moves for the given board state.
+*/
 
-        // Southeast
+MoveList gen_quiets(const Board& board)
+{
+    MoveList ml; // Move list structure.
 
-        u64_2 = DIAG_SE_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    if(board.side == WHITE) generate<WHITE, GEN_QUIETS>(board, ml);
+    else generate<BLACK, GEN_QUIETS>(board, ml);
 
-        u64_2 = (u64_2 >> 7) | (u64_2 >> 14) | (u64_2 >> 21) |
-            (u64_2 >> 28) | (u64_2 >> 35) | (u64_2 >> 42);
-        u64_2 &= DIAG_SE_LT[uint_1];
-        u64_2 ^= DIAG_SE_LT[uint_1];
+    return ml;
+}
 
-        if(u64_3) // Pop the capture move first.
-        {
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+/**
+    @brief Generates and returns a move list vector of the pseudo-legal
+           moves that may get the side to move out of check.
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
-            }
-        }
+    Only king moves are generated in double check. Otherwise, the other
+    pieces may only capture the checker or block its line. Every legal
+    move is included, but some moves may still leave the king in check.
 
-        // Southwest
+    @param board is the board to generate evasions for.
 
-        u64_2 = DIAG_SW_LT[uint_1] & OCC;
-        u64_3 = u64_2;
+    @return MoveList representing a collection of pseudo-legal evasions
+            for the given board state.
 
-        u64_2 = (u64_2 >> 9) | (u64_2 >> 18) | (u64_2 >> 27) |
-            (u64_2 >> 36) | (u64_2 >> 45) | (u64_2 >> 54);
-        u64_2 &= DIAG_SW_LT[uint_1];
-        u64_2 ^= DIAG_SW_LT[uint_1];
+    @warning The side to move must be in check.
+*/
 
-        if(u64_3) // Pop the capture move first.
-        {
-            uint_3 = POP_BIT(u64_2);
-            u64_3 = GET_BB(uint_3);
+MoveList gen_evasions(const Board& board)
+{
+    MoveList ml; // Move list structure.
 
-            if((gen_side == WHITE && (u64_3 & black_bb)) ||
-                (gen_side == BLACK && (u64_3 & white_bb)))
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-                    determine_type(board, u64_3), EMPTY, 0), board);
-            }
-        }
-    }
-}
-
-/**
-    @brief Generates and pushes all pseudo-legal pawn moves into the move
-           list vector for the given board state.
-
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
-
-    @return void.
-
-    @warning Pawns shouldn't be present on the promotion ranks (1 and 8).
-*/
-
-void gen_pawn_moves(bool gen_side, MoveList& ml, const Board& board)
-{
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
-
-    const uint64 OCC = white_bb | black_bb; // Occupied bitboard.
-    const uint64 FREE = ~OCC; // Free bitboard.
-
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_1, u64_2, u64_3, u64_4; // Temporary variables.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
-
-    if(gen_side == WHITE) // White Pawns
-    {
-        u64_1 = board.chessboard[wP];
-        bit_cnt = CNT_BITS(u64_1);
-
-        for(unsigned int i = 0; i < bit_cnt; i++)
-        {
-            // One cell upward
-
-            uint_1 = POP_BIT(u64_1);
-            u64_2 = GET_BB(uint_1);
-            u64_3 = (u64_2 << 8) & FREE;
-
-            if(u64_3)
-            {
-                u64_4 = u64_3;
-                uint_2 = POP_BIT(u64_4);
-
-                if(u64_3 & B_RANK[8]) // Check if the pawn reached rank 8.
-                {
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, wB, 0), board);
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, wR, 0), board);
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, wN, 0), board);
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, wQ, 0), board);
-                }
-                else
-                {
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, EMPTY, 0),
-                        board);
-                }
-
-                // Two cells upward
-
-                u64_2 = (u64_2 << 16) & B_RANK[4] & FREE;
-
-                if(u64_2 != 0ULL) push_quiet_move(ml,
-                    GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, MFLAGPS),
-                    board);
-            }
-
-            // Captures
-
-            u64_2 = GET_BB(uint_1);
-
-            // Capture left
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 << 7) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    (black_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 << 7) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    black_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, bP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[8]) // Check if the pawn reached rank 8.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-
-            // Capture right
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 << 9) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    (black_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 << 9) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    black_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, bP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[8]) // Check if the pawn reached rank 8.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-        }
-    }
-    else // Black Pawns
-    {
-        u64_1 = board.chessboard[bP];
-        bit_cnt = CNT_BITS(u64_1);
-
-        for(unsigned int i = 0; i < bit_cnt; i++)
-        {
-            // One cell downward
-
-            uint_1 = POP_BIT(u64_1);
-            u64_2 = GET_BB(uint_1);
-            u64_3 = (u64_2 >> 8) & FREE;
-
-            if(u64_3 != 0ULL)
-            {
-                u64_4 = u64_3;
-                uint_2 = POP_BIT(u64_4);
-
-                if(u64_3 & B_RANK[1]) // Check if the pawn reached rank 1.
-                {
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, bB, 0), board);
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, bR, 0), board);
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, bN, 0), board);
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, bQ, 0), board);
-                }
-                else
-                {
-                    push_quiet_move(ml,
-                        GET_MOVE(uint_1, uint_2, EMPTY, EMPTY, 0),
-                        board);
-                }
-
-                // Two cells downward
-
-                u64_2 = (u64_2 >> 16) & B_RANK[5] & FREE;
-
-                if(u64_2 != 0ULL) push_quiet_move(ml,
-                    GET_MOVE(uint_1, POP_BIT(u64_2), EMPTY, EMPTY, MFLAGPS),
-                    board);
-            }
-
-            // Captures
-
-            u64_2 = GET_BB(uint_1);
-
-            // Capture left
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 >> 7) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    (white_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 >> 7) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    white_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, wP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[1]) // Check if the pawn reached rank 1.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-
-            // Capture right
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 >> 9) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    (white_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 >> 9) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    white_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, wP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[1]) // Check if the pawn reached rank 1.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-        }
-    }
-}
-
-/**
-    @brief Generates and pushes all pseudo-legal pawn capture moves into the
-           move list vector for the given board state.
-
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
-
-    @return void.
-
-    @warning Pawns shouldn't be present on the promotion ranks (1 and 8).
-*/
-
-void gen_pawn_cap_moves(bool gen_side, MoveList& ml, const Board& board)
-{
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
-
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_1, u64_2, u64_3, u64_4; // Temporary variables.
-    unsigned int bit_cnt; // Number of bits; temporary variable.
-
-    if(gen_side == WHITE) // White Pawns
-    {
-        u64_1 = board.chessboard[wP];
-        bit_cnt = CNT_BITS(u64_1);
-
-        for(unsigned int i = 0; i < bit_cnt; i++)
-        {
-            // Captures
-
-            uint_1 = POP_BIT(u64_1);
-            u64_2 = GET_BB(uint_1);
-
-            // Capture left
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 << 7) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    (black_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 << 7) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    black_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, bP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[8]) // Check if the pawn reached rank 8.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-
-            // Capture right
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 << 9) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    (black_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 << 9) & B_RANK[GET_RANK(uint_1 + 8)] &
-                    black_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, bP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[8]) // Check if the pawn reached rank 8.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, wQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-        }
-    }
-    else // Black Pawns
-    {
-        u64_1 = board.chessboard[bP];
-        bit_cnt = CNT_BITS(u64_1);
-
-        for(unsigned int i = 0; i < bit_cnt; i++)
-        {
-            // Captures
-
-            uint_1 = POP_BIT(u64_1);
-            u64_2 = GET_BB(uint_1);
-
-            // Capture left
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 >> 7) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    (white_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 >> 7) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    white_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, wP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[1]) // Check if the pawn reached rank 1.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-
-            // Capture right
-
-            if(board.en_pas_sq != NO_SQ)
-            {
-                u64_3 = (u64_2 >> 9) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    (white_bb | GET_BB(board.en_pas_sq));
-            }
-            else
-            {
-                u64_3 = (u64_2 >> 9) & B_RANK[GET_RANK(uint_1 - 8)] &
-                    white_bb;
-            }
-
-            if(u64_3)
-            {
-                assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-                uint_2 = determine_type(board, u64_3);
-                u64_4 = u64_3;
-                uint_3 = POP_BIT(u64_4);
-
-                if(uint_3 == board.en_pas_sq)
-                {
-                    push_enp_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, wP, EMPTY, MFLAGEP));
-                }
-                else if(u64_3 & B_RANK[1]) // Check if the pawn reached rank 1.
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bB, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bR, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bN, 0), board);
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, bQ, 0), board);
-                }
-                else
-                {
-                    push_capture_move(ml,
-                        GET_MOVE(uint_1, uint_3, uint_2, EMPTY, 0), board);
-                }
-            }
-        }
-    }
-}
-
-/**
-    @brief Generates and pushes all pseudo-legal king moves into the move
-           list vector for the given board state.
-
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
-
-    @return void.
-
-    @warning There must be exactly ONE king (zero is also invalid).
-*/
-
-void gen_king_moves(bool gen_side, MoveList& ml, const Board& board)
-{
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
-
-    const uint64 FREE = ~white_bb & ~black_bb; // Free bitboard.
-
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_1, u64_2; // Temporary variable.
-    bool not_in_check; // Temporary variable.
-
-    // Generation
-
-    if(gen_side == WHITE) u64_1 = board.chessboard[wK];
-    else u64_1 = board.chessboard[bK];
-
-    assert((u64_1 != 0ULL) && ((u64_1 & (u64_1 - 1)) == 0ULL));
-
-    uint_1 = POP_BIT(u64_1);
-
-    // Captures
-
-    if(gen_side == WHITE) u64_1 = KING_LT[uint_1] & black_bb;
-    else u64_1 = KING_LT[uint_1] & white_bb;
-
-    uint_2 = CNT_BITS(u64_1);
-
-    for(unsigned int i = 0; i < uint_2; i++) // Push capture moves.
-    {
-        uint_3 = POP_BIT(u64_1);
-        u64_2 = GET_BB(uint_3);
-        assert((u64_2 != 0ULL) && ((u64_2 & (u64_2 - 1)) == 0ULL));
-        push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-            determine_type(board, u64_2), EMPTY, 0), board);
-    }
-
-    u64_1 = KING_LT[uint_1] & FREE;
-
-    uint_2 = CNT_BITS(u64_1);
-
-    for(unsigned int i = 0; i < uint_2; i++) // Push quiet moves.
-    {
-        push_quiet_move(ml, GET_MOVE(uint_1, POP_BIT(u64_1),
-            EMPTY, EMPTY, 0), board);
-    }
-
-    // Castling
-
-    if(board.castle_perm &&
-        ((gen_side == WHITE && uint_1 == e1) ||
-        (gen_side == BLACK && uint_1 == e8)))
-    {
-        if(gen_side == WHITE)
-        {
-            not_in_check = !is_sq_attacked(e1, WHITE, board);
-
-            if(board.castle_perm & WKCA) // White king-side castling
-            {
-                if(not_in_check && (determine_type(board, GET_BB(f1)) == EMPTY) &&
-                    (determine_type(board, GET_BB(g1)) == EMPTY) &&
-                    !is_sq_attacked(f1, WHITE, board))
-                {
-                    push_castling_move(ml, GET_MOVE(e1, g1, EMPTY, EMPTY,
-                        MFLAGCA));
-                }
-            }
-
-            if(board.castle_perm & WQCA) // White queen-side castling
-            {
-                if(not_in_check && (determine_type(board, GET_BB(d1)) == EMPTY) &&
-                    (determine_type(board, GET_BB(c1)) == EMPTY) &&
-                    (determine_type(board, GET_BB(b1)) == EMPTY) &&
-                    !is_sq_attacked(d1, WHITE, board))
-                {
-                    push_castling_move(ml, GET_MOVE(e1, c1, EMPTY, EMPTY,
-                        MFLAGCA));
-                }
-            }
-        }
-        else
-        {
-            not_in_check = !is_sq_attacked(e8, BLACK, board);
-
-            if(board.castle_perm & BKCA) // Black king-side castling
-            {
-                if(not_in_check && (determine_type(board, GET_BB(f8)) == EMPTY) &&
-                    (determine_type(board, GET_BB(g8)) == EMPTY) &&
-                    !is_sq_attacked(f8, BLACK, board))
-                {
-                    push_castling_move(ml, GET_MOVE(e8, g8, EMPTY, EMPTY,
-                        MFLAGCA));
-                }
-            }
-
-            if(board.castle_perm & BQCA) // Black queen-side castling
-            {
-                if(not_in_check && (determine_type(board, GET_BB(d8)) == EMPTY) &&
-                    (determine_type(board, GET_BB(c8)) == EMPTY) &&
-                    (determine_type(board, GET_BB(b8)) == EMPTY) &&
-                    !is_sq_attacked(d8, BLACK, board))
-                {
-                    push_castling_move(ml, GET_MOVE(e8, c8, EMPTY, EMPTY,
-                        MFLAGCA));
-                }
-            }
-        }
-    }
-}
-
-/**
-    @brief Generates and pushes all pseudo-legal king capture moves into the
-           move list vector for the given board state.
-
-    @param gen_side is the side to generate moves for.
-    @param ml is the move list structure to which the generated moves are
-           to be pushed.
-    @param board is the board on which the moves are to be generated.
-
-    @return void.
-
-    @warning There must be exactly ONE king (zero is also invalid).
-*/
-
-void gen_king_cap_moves(bool gen_side, MoveList& ml, const Board& board)
-{
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
-
-    unsigned int uint_1, uint_2, uint_3; // Temporary variables.
-    uint64 u64_1, u64_2; // Temporary variable.
-
-    // Generation
-
-    if(gen_side == WHITE) u64_1 = board.chessboard[wK];
-    else u64_1 = board.chessboard[bK];
-
-    assert((u64_1 != 0ULL) && ((u64_1 & (u64_1 - 1)) == 0ULL));
-
-    uint_1 = POP_BIT(u64_1);
-
-    // Captures
-
-    if(gen_side == WHITE) u64_1 = KING_LT[uint_1] & black_bb;
-    else u64_1 = KING_LT[uint_1] & white_bb;
-
-    uint_2 = CNT_BITS(u64_1);
-
-    for(unsigned int i = 0; i < uint_2; i++) // Push capture moves.
-    {
-        uint_3 = POP_BIT(u64_1);
-        u64_2 = GET_BB(uint_3);
-        assert((u64_2 != 0ULL) && ((u64_2 & (u64_2 - 1)) == 0ULL));
-        push_capture_move(ml, GET_MOVE(uint_1, uint_3,
-            determine_type(board, u64_2), EMPTY, 0), board);
-    }
-}
-
-/**
-    @brief Determines whether the given cell index is under attack.
-
-    This function efficiently generates captures moves and such, to check
-    the given cell is currently under attack for the player denoted by
-    'gen_side'. It works by imagining a rook and bishop on the cell, belonging
-    to 'gen_side', and finding if this rook or bishop attacks any pieces.
-    If the attacked pieces happen to be queens, rooks or bishops of the
-    opposite side, the cell is under attack. There are also checks to check
-    for pawns and knights. A lot effort was put into making this function fast.
-
-    @param index is the integer index of the cell to check in LERF layout.
-    @param gen_side is the side to be considered when checking whether the cell
-           indexed by 'index' is attacked. It represents the defender.
-    @param board is the board to check on.
-
-    @return bool denoting whether the cell indexed by 'index' is under attack
-            by the opposite side (opposite to 'gen_side').
-
-    @warning 'index' must be between (or equal to) 0 and 63.
-    @warning 'index' must be in LERF layout.
-*/
-
-bool is_sq_attacked(unsigned int index, bool gen_side, const Board& board)
-{
-    const uint64 white_bb = board.chessboard[ALL_WHITE]; // White bitboard.
-    const uint64 black_bb = board.chessboard[ALL_BLACK]; // Black bitboard.
-
-    const uint64 OCC = white_bb | black_bb; // Occupied bitboard.
-
-    unsigned int uint_1, uint_2; // Temporary variables.
-    uint64 u64_1, u64_2, u64_3; // Temporary variables.
-
-    u64_1 = GET_BB(index);
-
-    // Check for pawns
-
-    if(gen_side == WHITE && (u64_1 & B_RANK[8]) == 0ULL) // Black pawns
-    {
-        if(((u64_1 << 7 | u64_1 << 9) & B_RANK[GET_RANK(index + 8)])
-            & board.chessboard[bP])
-            return 1;
-    }
-    else if((u64_1 & B_RANK[1]) == 0ULL) // White pawns
-    {
-        if(((u64_1 >> 7 | u64_1 >> 9) & B_RANK[GET_RANK(index - 8)])
-            & board.chessboard[wP])
-            return 1;
-    }
-
-    // Check knights
-
-    if(gen_side == WHITE) u64_2 = KNIGHT_LT[index] & black_bb;
-    else u64_2 = KNIGHT_LT[index] & white_bb;
-
-    uint_1 = CNT_BITS(u64_2);
-
-    for(unsigned int i = 0; i < uint_1; i++)
-    {
-        u64_3 = GET_BB(POP_BIT(u64_2));
-
-        assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-        uint_2 = determine_type(board, u64_3);
-
-        if(gen_side == WHITE) // Check if black knight
-        {
-            if(uint_2 == bN) return 1;
-        }
-        else // Check if white knight
-        {
-            if(uint_2 == wN) return 1;
-        }
-    }
-
-    // Check lines
-
-    // North
-
-    u64_2 = LINE_N_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 << 8) | (u64_2 << 16) | (u64_2 << 24) |
-        (u64_2 << 32) | (u64_2 << 40) | (u64_2 << 48);
-    u64_2 &= LINE_N_LT[index];
-    u64_2 ^= LINE_N_LT[index];
-
-    if(u64_3)
-    {
-        uint_2 = CNT_BITS(u64_2);
-        uint_2--;
-    }
-    else uint_2 = CNT_BITS(u64_2);
-
-    for(unsigned int i = 0; i < uint_2; i++) POP_BIT(u64_2);
-
-    if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-        (gen_side == BLACK && (u64_2 & white_bb))))
-    {
-        assert((u64_2 != 0ULL) && ((u64_2 & (u64_2 - 1)) == 0ULL));
-        uint_2 = determine_type(board, u64_2);
-
-        if(gen_side == WHITE) // Check if black rook/queen
-        {
-            if(uint_2 == bR || uint_2 == bQ) return 1;
-        }
-        else // Check if white rook/queen
-        {
-            if(uint_2 == wR || uint_2 == wQ) return 1;
-        }
-    }
-
-    // South
-
-    u64_2 = LINE_S_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 >> 8) | (u64_2 >> 16) | (u64_2 >> 24) |
-        (u64_2 >> 32) | (u64_2 >> 40) | (u64_2 >> 48);
-    u64_2 &= LINE_S_LT[index];
-    u64_2 ^= LINE_S_LT[index];
-
-    if(u64_3)
-    {
-        u64_3 = GET_BB(POP_BIT(u64_2));
-
-        if((gen_side == WHITE && (u64_3 & black_bb)) ||
-            (gen_side == BLACK && (u64_3 & white_bb)))
-        {
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            uint_2 = determine_type(board, u64_3);
-
-            if(gen_side == WHITE) // Check if black rook/queen
-            {
-                if(uint_2 == bR || uint_2 == bQ) return 1;
-            }
-            else // Check if white rook/queen
-            {
-                if(uint_2 == wR || uint_2 == wQ) return 1;
-            }
-        }
-    }
-
-    // East
-
-    u64_2 = LINE_E_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 << 1) | (u64_2 << 2) | (u64_2 << 3) |
-        (u64_2 << 4) | (u64_2 << 5) | (u64_2 << 6);
-    u64_2 &= LINE_E_LT[index];
-    u64_2 ^= LINE_E_LT[index];
-
-    if(u64_3)
-    {
-        uint_2 = CNT_BITS(u64_2);
-        uint_2--;
-    }
-    else uint_2 = CNT_BITS(u64_2);
-
-    for(unsigned int i = 0; i < uint_2; i++) POP_BIT(u64_2);
-
-    if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-        (gen_side == BLACK && (u64_2 & white_bb))))
-    {
-        assert((u64_2 != 0ULL) && ((u64_2 & (u64_2 - 1)) == 0ULL));
-        uint_2 = determine_type(board, u64_2);
-
-        if(gen_side == WHITE) // Check if black rook/queen
-        {
-            if(uint_2 == bR || uint_2 == bQ) return 1;
-        }
-        else // Check if white rook/queen
-        {
-            if(uint_2 == wR || uint_2 == wQ) return 1;
-        }
-    }
-
-    // West
-
-    u64_2 = LINE_W_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 >> 1) | (u64_2 >> 2) | (u64_2 >> 3) |
-        (u64_2 >> 4) | (u64_2 >> 5) | (u64_2 >> 6);
-    u64_2 &= LINE_W_LT[index];
-    u64_2 ^= LINE_W_LT[index];
-
-    if(u64_3)
-    {
-        u64_3 = GET_BB(POP_BIT(u64_2));
-
-        if((gen_side == WHITE && (u64_3 & black_bb)) ||
-            (gen_side == BLACK && (u64_3 & white_bb)))
-        {
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            uint_2 = determine_type(board, u64_3);
-
-            if(gen_side == WHITE) // Check if black rook/queen
-            {
-                if(uint_2 == bR || uint_2 == bQ) return 1;
-            }
-            else // Check if white rook/queen
-            {
-                if(uint_2 == wR || uint_2 == wQ) return 1;
-            }
-        }
-    }
-
-    // Check diagonals
-
-    // Northeast
-
-    u64_2 = DIAG_NE_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 << 9) | (u64_2 << 18) | (u64_2 << 27) |
-        (u64_2 << 36) | (u64_2 << 45) | (u64_2 << 54);
-    u64_2 &= DIAG_NE_LT[index];
-    u64_2 ^= DIAG_NE_LT[index];
-
-    if(u64_3)
-    {
-        uint_2 = CNT_BITS(u64_2);
-        uint_2--;
-    }
-    else uint_2 = CNT_BITS(u64_2);
-
-    for(unsigned int i = 0; i < uint_2; i++) POP_BIT(u64_2);
-
-    if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-        (gen_side == BLACK && (u64_2 & white_bb))))
-    {
-        assert((u64_2 != 0ULL) && ((u64_2 & (u64_2 - 1)) == 0ULL));
-        uint_2 = determine_type(board, u64_2);
-
-        if(gen_side == WHITE) // Check if black bishop/queen
-        {
-            if(uint_2 == bB || uint_2 == bQ) return 1;
-        }
-        else // Check if white bishop/queen
-        {
-            if(uint_2 == wB || uint_2 == wQ) return 1;
-        }
-    }
-
-    // Northwest
-
-    u64_2 = DIAG_NW_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 << 7) | (u64_2 << 14) | (u64_2 << 21) |
-        (u64_2 << 28) | (u64_2 << 35) | (u64_2 << 42);
-    u64_2 &= DIAG_NW_LT[index];
-    u64_2 ^= DIAG_NW_LT[index];
-
-    if(u64_3)
-    {
-        uint_2 = CNT_BITS(u64_2);
-        uint_2--;
-    }
-    else uint_2 = CNT_BITS(u64_2);
-
-    for(unsigned int i = 0; i < uint_2; i++) POP_BIT(u64_2);
-
-    if(u64_3 && ((gen_side == WHITE && (u64_2 & black_bb)) ||
-        (gen_side == BLACK && (u64_2 & white_bb))))
-    {
-        assert((u64_2 != 0ULL) && ((u64_2 & (u64_2 - 1)) == 0ULL));
-        uint_2 = determine_type(board, u64_2);
-
-        if(gen_side == WHITE) // Check if black bishop/queen
-        {
-            if(uint_2 == bB || uint_2 == bQ) return 1;
-        }
-        else // Check if white bishop/queen
-        {
-            if(uint_2 == wB || uint_2 == wQ) return 1;
-        }
-    }
-
-    // Southeast
-
-    u64_2 = DIAG_SE_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 >> 7) | (u64_2 >> 14) | (u64_2 >> 21) |
-        (u64_2 >> 28) | (u64_2 >> 35) | (u64_2 >> 42);
-    u64_2 &= DIAG_SE_LT[index];
-    u64_2 ^= DIAG_SE_LT[index];
-
-    if(u64_3)
-    {
-        u64_3 = GET_BB(POP_BIT(u64_2));
-
-        if((gen_side == WHITE && (u64_3 & black_bb)) ||
-            (gen_side == BLACK && (u64_3 & white_bb)))
-        {
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            uint_2 = determine_type(board, u64_3);
-
-            if(gen_side == WHITE) // Check if black bishop/queen
-            {
-                if(uint_2 == bB || uint_2 == bQ) return 1;
-            }
-            else // Check if white bishop/queen
-            {
-                if(uint_2 == wB || uint_2 == wQ) return 1;
-            }
-        }
-    }
-
-    // Southwest
-
-    u64_2 = DIAG_SW_LT[index] & OCC;
-    u64_3 = u64_2;
-
-    u64_2 = (u64_2 >> 9) | (u64_2 >> 18) | (u64_2 >> 27) |
-        (u64_2 >> 36) | (u64_2 >> 45) | (u64_2 >> 54);
-    u64_2 &= DIAG_SW_LT[index];
-    u64_2 ^= DIAG_SW_LT[index];
-
-    if(u64_3)
-    {
-        u64_3 = GET_BB(POP_BIT(u64_2));
-
-        if((gen_side == WHITE && (u64_3 & black_bb)) ||
-            (gen_side == BLACK && (u64_3 & white_bb)))
-        {
-            assert((u64_3 != 0ULL) && ((u64_3 & (u64_3 - 1)) == 0ULL));
-            uint_2 = determine_type(board, u64_3);
-
-            if(gen_side == WHITE) // Check if black bishop/queen
-            {
-                if(uint_2 == bB || uint_2 == bQ) return 1;
-            }
-            else // Check if white bishop/queen
-            {
-                if(uint_2 == wB || uint_2 == wQ) return 1;
-            }
-        }
-    }
-
-    // Check neighbouring cells for kings
-
-    if(gen_side == WHITE) // Check for black king
-    {
-        if(KING_LT[index] & board.chessboard[bK]) return 1;
-    }
-    else // Check for white king
-    {
-        if(KING_LT[index] & board.chessboard[wK]) return 1;
-    }
-
-    return 0;
-}
-
-/**
-    @brief Generates and returns a move list vector of all the possible
-           pseudo-legal moves for the given board state.
-
-    @param board is the board to generate all pseudo-legal moves for.
-
-    @return MoveList representing a collection of all pseudo-legal
-            moves for the given board state.
-*/
-
-MoveList gen_moves(const Board& board)
-{
-    MoveList ml; // Move list structure.
-
-    // Queens
-
-    // Line moves
-
-    if(board.side == WHITE) // White queens
-        gen_rook_moves(board.chessboard[wQ], WHITE, ml, board);
-    else // Black queens
-        gen_rook_moves(board.chessboard[bQ], BLACK, ml, board);
-
-    // Diagonal moves
-
-    if(board.side == WHITE) // White queens
-        gen_bishop_moves(board.chessboard[wQ], WHITE, ml, board);
-    else // Black queens
-        gen_bishop_moves(board.chessboard[bQ], BLACK, ml, board);
-
-    // Rooks
-
-    if(board.side == WHITE) // White rooks
-        gen_rook_moves(board.chessboard[wR], WHITE, ml, board);
-    else // Black rooks
-        gen_rook_moves(board.chessboard[bR], BLACK, ml, board);
-
-    // Knights
-
-    if(board.side == WHITE) // White knights
-        gen_knight_moves(board.chessboard[wN], WHITE, ml, board);
-    else // Black knights
-        gen_knight_moves(board.chessboard[bN], BLACK, ml, board);
-
-    // Bishops
-
-    if(board.side == WHITE) // White bishops
-        gen_bishop_moves(board.chessboard[wB], WHITE, ml, board);
-    else // Black bishops
-        gen_bishop_moves(board.chessboard[bB], BLACK, ml, board);
-
-    // Pawns
-
-    gen_pawn_moves(board.side, ml, board);
-
-    // King
-
-    gen_king_moves(board.side, ml, board);
+    if(board.side == WHITE) generate<WHITE, GEN_EVASIONS>(board, ml);
+    else generate<BLACK, GEN_EVASIONS>(board, ml);
 
     return ml;
 }
 
 /**
-    @brief Generates and returns a move list vector of all the possible
-           pseudo-legal capture moves for the given board state.
+    @brief Generates and returns a move list vector of the pseudo-legal
+           quiet moves that give direct check.
 
-    @param board is the board to generate all pseudo-legal capture moves for.
+    Discovered checks, promotions and castling are not included.
 
-    @return MoveList representing a collection of all pseudo-legal
-            capture moves for the given board state.
+    @param board is the board to generate quiet checks for.
+
+    @return MoveList representing a collection of pseudo-legal quiet
+            checks for the given board state.
 */
 
-MoveList gen_captures(const Board& board)
+MoveList gen_quiet_checks(const Board& board)
 {
     MoveList ml; // Move list structure.
 
-    // Queens
-
-    // Line moves
-
-    if(board.side == WHITE) // White queens
-        gen_rook_cap_moves(board.chessboard[wQ], WHITE, ml, board);
-    else // Black queens
-        gen_rook_cap_moves(board.chessboard[bQ], BLACK, ml, board);
-
-    // Diagonal moves
-
-    if(board.side == WHITE) // White queens
-        gen_bishop_cap_moves(board.chessboard[wQ], WHITE, ml, board);
-    else // Black queens
-        gen_bishop_cap_moves(board.chessboard[bQ], BLACK, ml, board);
-
-    // Rooks
-
-    if(board.side == WHITE) // White rooks
-        gen_rook_cap_moves(board.chessboard[wR], WHITE, ml, board);
-    else // Black rooks
-        gen_rook_cap_moves(board.chessboard[bR], BLACK, ml, board);
-
-    // Knights
-
-    if(board.side == WHITE) // White knights
-        gen_knight_cap_moves(board.chessboard[wN], WHITE, ml, board);
-    else // Black knights
-        gen_knight_cap_moves(board.chessboard[bN], BLACK, ml, board);
-
-    // Bishops
-
-    if(board.side == WHITE) // White bishops
-        gen_bishop_cap_moves(board.chessboard[wB], WHITE, ml, board);
-    else // Black bishops
-        gen_bishop_cap_moves(board.chessboard[bB], BLACK, ml, board);
-
-    // Pawns
-
-    gen_pawn_cap_moves(board.side, ml, board);
-
-    // King
-
-    gen_king_cap_moves(board.side, ml, board);
+    if(board.side == WHITE) generate<WHITE, GEN_QUIET_CHECKS>(board, ml);
+    else generate<BLACK, GEN_QUIET_CHECKS>(board, ml);
 
     return ml;
 }
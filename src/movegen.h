@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename movegen.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.2
 
     @brief Generates moves given a board position.
 
@@ -15,6 +15,9 @@
     * 29/11/2015 0.1.1 Added functions to generate just captures.
     * 05/12/2015 0.1.2 Added functions to generate legal moves and captures.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added is_pseudo_legal(const Board&, unsigned int).
+    * 17/10/2026 1.0.2 Replaced per-piece generators with one templated generator.
+        * Added attackers_to(), gen_quiets(), gen_evasions() and gen_quiet_checks().
 */
 
 /**
@@ -78,46 +81,28 @@ extern void init_mvv_lva(); // Initialise MVV-LVA scores table.
 
 extern std::string pretty_move_list(const std::vector<Move>& list);
 
-// Generate moves for rooks/line moves for queens.
+// Return every piece, of either side, that attacks a cell.
 
-extern void gen_rook_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-extern void gen_rook_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-
-// Generate moves for knights.
-
-extern void gen_knight_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-extern void gen_knight_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
+extern uint64 attackers_to(const Board& board, unsigned int index, uint64 occ);
 
-// Generate moves for bishops/diagonal moves for queens.
+// Check if a cell is under attack.
 
-extern void gen_bishop_moves(uint64 u64_1, bool gen_side, MoveList& ml,
-    const Board& board);
-extern void gen_bishop_cap_moves(uint64 u64_1, bool gen_side, MoveList& ml,
+extern bool is_sq_attacked(unsigned int index, bool gen_side,
     const Board& board);
 
-// Generate moves for pawns.
+// Check if a move is pseudo-legal without generating moves.
 
-extern void gen_pawn_moves(bool gen_side, MoveList& ml, const Board& board);
-extern void gen_pawn_cap_moves(bool gen_side, MoveList& ml,
-    const Board& board);
+extern bool is_pseudo_legal(const Board& board, unsigned int move);
 
-// Generate moves for kings.
+extern MoveList gen_moves(const Board& board); // Generate all moves.
+extern MoveList gen_captures(const Board& board); // Generate all captures.
+extern MoveList gen_quiets(const Board& board); // Generate all quiet moves.
+extern MoveList gen_evasions(const Board& board); // Generate check evasions.
 
-extern void gen_king_moves(bool gen_side, MoveList& ml, const Board& board);
-extern void gen_king_cap_moves(bool gen_side, MoveList& ml,
-    const Board& board);
+// Generate quiet moves that give direct check.
 
-// Check if a cell is under attack.
+extern MoveList gen_quiet_checks(const Board& board);
 
-extern bool is_sq_attacked(unsigned int index, bool gen_side,
-    const Board& board);
-
-extern MoveList gen_moves(const Board& board); // Generate all moves.
-extern MoveList gen_captures(const Board& board); // Generate all captures.
 extern MoveList gen_legal_moves(Board& board); // Generate legal moves.
 
 // Generate legal captures.
@@ -0,0 +1,407 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename packed_pos.cc
+    @author Shreyas Vinod
+    @version 0.1.2
+
+    @brief Handles a compact, 32-byte binary encoding of positions.
+
+    Converts boards to and from a fixed size binary record holding the
+    occupancy bitboard, a 4-bit code for each occupied cell, the side to move,
+    castling permissions, the en passant square, counters and an optional
+    score and game result label. Records can be appended to and read from
+    files in bulk, for training data and evaluation tuning.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 The full move number is stored and restored through Board::start_ply.
+    * 17/10/2026 0.1.2 unpack_board() rejects positions without one king a side, with impossible castling rights or en passant squares, or pawns on the back ranks.
+*/
+
+/**
+    @file
+    @filename packed_pos.cc
+    @author Shreyas Vinod
+
+    @brief Handles a compact, 32-byte binary encoding of positions.
+
+    Converts boards to and from a fixed size binary record holding the
+    occupancy bitboard, a 4-bit code for each occupied cell, the side to move,
+    castling permissions, the en passant square, counters and an optional
+    score and game result label. Records can be appended to and read from
+    files in bulk, for training data and evaluation tuning.
+*/
+
+#include "defs.h"
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <fstream> // std::ifstream and std::ofstream
+
+#include "packed_pos.h"
+#include "board.h"
+#include "hash.h" // gen_hash()
+
+// Prototypes
+
+void pack_board(const Board& board, PackedPos& packed);
+bool unpack_board(Board& board, const PackedPos& packed);
+void label_packed(PackedPos& packed, int score, int result);
+bool open_writer(PackedWriter& writer, const std::string& path, bool append);
+void write_packed(PackedWriter& writer, const PackedPos& packed);
+void write_packed(PackedWriter& writer, const std::vector<PackedPos>& packed);
+void flush_writer(PackedWriter& writer);
+void close_writer(PackedWriter& writer);
+bool open_reader(PackedReader& reader, const std::string& path);
+bool read_packed(PackedReader& reader, PackedPos& packed);
+unsigned int read_packed(PackedReader& reader, std::vector<PackedPos>& packed,
+    unsigned int max);
+void close_reader(PackedReader& reader);
+
+// Function definitions
+
+/**
+    @brief Packs a board into 32 bytes.
+
+    @param board is the board to pack.
+    @param packed is the packed position to fill. It is left unlabelled.
+
+    @return void.
+*/
+
+void pack_board(const Board& board, PackedPos& packed)
+{
+    unsigned char cells[64];
+    uint64 bb;
+    unsigned int n = 0;
+
+    for(unsigned int i = wP; i <= bK; i++)
+    {
+        bb = board.chessboard[i];
+        while(bb) cells[POP_BIT(bb)] = i;
+    }
+
+    packed.occupancy = board.chessboard[ALL_WHITE] |
+        board.chessboard[ALL_BLACK];
+
+    for(unsigned int i = 0; i < 16; i++) packed.pieces[i] = 0;
+
+    bb = packed.occupancy;
+
+    while(bb)
+    {
+        packed.pieces[n >> 1] |= cells[POP_BIT(bb)] << ((n & 1) << 2);
+        n++;
+    }
+
+    packed.state = (board.side == WHITE ? PK_SIDE : 0) |
+        (board.castle_perm << 1);
+    packed.en_pas_sq = board.en_pas_sq;
+    packed.fifty = board.fifty;
+    packed.result = RESULT_DRAW;
+    packed.move_num = ((board.start_ply + board.his_ply) / 2) + 1;
+    packed.score = 0;
+}
+
+/**
+    @brief Initialises a board from a packed position.
+
+    @param board is the board to initialise.
+    @param packed is the packed position.
+
+    @return bool value representing whether initialisation was successful,
+            that is, whether the packed position was sane: valid piece codes,
+            one king a side, no pawns on the first or eighth rank, castling
+            rights only with the king and rook on their starting squares,
+            and an en passant square, if any, on the sixth rank with white
+            to move or the third with black to move.
+
+    @warning This will reset 'board', just like parse_fen().
+*/
+
+bool unpack_board(Board& board, const PackedPos& packed)
+{
+    uint64 bb = packed.occupancy;
+    unsigned int n = 0, piece;
+
+    if(CNT_BITS(bb) > 32) return 0; // Too many pieces.
+
+    reset_board(board);
+
+    while(bb)
+    {
+        piece = (packed.pieces[n >> 1] >> ((n & 1) << 2)) & 0xf;
+        if(piece > bK) return 0; // Bad piece code.
+
+        board.chessboard[piece] |= GET_BB(POP_BIT(bb));
+        n++;
+    }
+
+    board.side = (packed.state & PK_SIDE) ? WHITE : BLACK;
+    board.castle_perm = (packed.state >> 1) & 0xf;
+    board.en_pas_sq = packed.en_pas_sq;
+
+    // Move generation expects one king a side, no pawns on the back ranks,
+    // castling rights only with the king and rook at home, and an en
+    // passant square behind the side not to move.
+
+    if(CNT_BITS(board.chessboard[wK]) != 1 ||
+        CNT_BITS(board.chessboard[bK]) != 1) return 0;
+
+    if((board.chessboard[wP] | board.chessboard[bP]) &
+        (B_RANK[RANK_1] | B_RANK[RANK_8])) return 0;
+
+    if((board.castle_perm & (WKCA | WQCA)) &&
+        !(board.chessboard[wK] & GET_BB(e1))) return 0;
+    if((board.castle_perm & WKCA) && !(board.chessboard[wR] & GET_BB(h1)))
+        return 0;
+    if((board.castle_perm & WQCA) && !(board.chessboard[wR] & GET_BB(a1)))
+        return 0;
+    if((board.castle_perm & (BKCA | BQCA)) &&
+        !(board.chessboard[bK] & GET_BB(e8))) return 0;
+    if((board.castle_perm & BKCA) && !(board.chessboard[bR] & GET_BB(h8)))
+        return 0;
+    if((board.castle_perm & BQCA) && !(board.chessboard[bR] & GET_BB(a8)))
+        return 0;
+
+    if(board.en_pas_sq != NO_SQ && (board.en_pas_sq > NO_SQ ||
+        GET_RANK(board.en_pas_sq) != (board.side == WHITE ? RANK_6 : RANK_3)))
+        return 0;
+    board.fifty = packed.fifty;
+    board.start_ply = (packed.move_num ? (packed.move_num - 1) * 2 : 0) +
+        (board.side == BLACK);
+
+    update_secondary(board); // Update 'all white' and 'all black' boards.
+
+    board.hash_key = gen_hash(board); // Generate zobrist hash.
+
+    return 1;
+}
+
+/**
+    @brief Attaches a score and game result to a packed position.
+
+    @param packed is the packed position to label.
+    @param score is the search score, from the point of view of the side to
+           move.
+    @param result is the game result, from the point of view of the side to
+           move; RESULT_LOSS, RESULT_DRAW or RESULT_WIN.
+
+    @return void.
+
+    @warning 'score' is clamped to fit in 16 bits.
+*/
+
+void label_packed(PackedPos& packed, int score, int result)
+{
+    if(score > 32767) score = 32767;
+    else if(score < -32767) score = -32767;
+
+    packed.state |= PK_LABELLED;
+    packed.score = score;
+    packed.result = result;
+}
+
+/**
+    @brief Opens a file to append packed positions to.
+
+    @param writer is the writer to open.
+    @param path is the path of the file.
+    @param append denotes whether to add to the end of an existing file,
+           rather than truncating it.
+
+    @return bool denoting whether the file could be opened.
+*/
+
+bool open_writer(PackedWriter& writer, const std::string& path, bool append)
+{
+    close_writer(writer);
+
+    writer.file.open(path, std::ios::binary |
+        (append ? std::ios::app : std::ios::trunc));
+
+    writer.buffer.reserve(PACKED_BUFFER);
+    writer.count = 0;
+
+    return writer.file.is_open();
+}
+
+/**
+    @brief Appends a packed position. It is buffered, and written out once
+           'PACKED_BUFFER' positions are waiting.
+
+    @param writer is the writer to append to.
+    @param packed is the packed position.
+
+    @return void.
+*/
+
+void write_packed(PackedWriter& writer, const PackedPos& packed)
+{
+    writer.buffer.push_back(packed);
+    writer.count++;
+
+    if(writer.buffer.size() >= PACKED_BUFFER) flush_writer(writer);
+}
+
+/**
+    @brief Appends many packed positions at once, bypassing the buffer.
+
+    @param writer is the writer to append to.
+    @param packed is the list of packed positions.
+
+    @return void.
+*/
+
+void write_packed(PackedWriter& writer, const std::vector<PackedPos>& packed)
+{
+    if(packed.empty()) return;
+
+    flush_writer(writer); // Keep the order of records.
+
+    writer.file.write(reinterpret_cast<const char*>(packed.data()),
+        packed.size() * sizeof(PackedPos));
+    writer.count += packed.size();
+}
+
+/**
+    @brief Writes out any buffered packed positions.
+
+    @param writer is the writer to flush.
+
+    @return void.
+*/
+
+void flush_writer(PackedWriter& writer)
+{
+    if(writer.buffer.empty()) return;
+
+    writer.file.write(reinterpret_cast<const char*>(writer.buffer.data()),
+        writer.buffer.size() * sizeof(PackedPos));
+    writer.file.flush();
+    writer.buffer.clear();
+}
+
+/**
+    @brief Flushes and closes a writer.
+
+    @param writer is the writer to close.
+
+    @return void.
+*/
+
+void close_writer(PackedWriter& writer)
+{
+    if(!writer.file.is_open()) return;
+
+    flush_writer(writer);
+    writer.file.close();
+}
+
+/**
+    @brief Opens a file of packed positions for reading.
+
+    @param reader is the reader to open.
+    @param path is the path of the file.
+
+    @return bool denoting whether the file could be opened.
+*/
+
+bool open_reader(PackedReader& reader, const std::string& path)
+{
+    close_reader(reader);
+
+    reader.file.open(path, std::ios::binary);
+
+    reader.buffer.clear();
+    reader.index = 0;
+    reader.count = 0;
+
+    return reader.file.is_open();
+}
+
+/**
+    @brief Reads the next packed position, refilling the buffer from the
+           file when it runs dry.
+
+    @param reader is the reader to read from.
+    @param packed is the packed position to fill.
+
+    @return bool denoting whether a position was read, that is, whether the
+            end of the file hadn't already been reached.
+
+    @warning A truncated record at the end of the file is ignored.
+*/
+
+bool read_packed(PackedReader& reader, PackedPos& packed)
+{
+    if(reader.index == reader.buffer.size())
+    {
+        reader.buffer.resize(PACKED_BUFFER);
+        reader.file.read(reinterpret_cast<char*>(reader.buffer.data()),
+            PACKED_BUFFER * sizeof(PackedPos));
+        reader.buffer.resize(reader.file.gcount() / sizeof(PackedPos));
+        reader.index = 0;
+
+        if(reader.buffer.empty()) return 0;
+    }
+
+    packed = reader.buffer[reader.index++];
+    reader.count++;
+
+    return 1;
+}
+
+/**
+    @brief Reads up to 'max' packed positions at once.
+
+    @param reader is the reader to read from.
+    @param packed is the list to fill, which is resized to hold exactly the
+           positions read.
+    @param max is the maximum number of positions to read.
+
+    @return unsigned int denoting the number of positions read, which is
+            zero at the end of the file.
+*/
+
+unsigned int read_packed(PackedReader& reader, std::vector<PackedPos>& packed,
+    unsigned int max)
+{
+    packed.clear();
+
+    // Drain the buffer first, then read the rest straight from the file.
+
+    while(packed.size() < max && reader.index < reader.buffer.size())
+        packed.push_back(reader.buffer[reader.index++]);
+
+    unsigned int n = packed.size();
+
+    if(n < max)
+    {
+        packed.resize(max);
+        reader.file.read(reinterpret_cast<char*>(packed.data() + n),
+            (max - n) * sizeof(PackedPos));
+        packed.resize(n + reader.file.gcount() / sizeof(PackedPos));
+    }
+
+    reader.count += packed.size();
+
+    return packed.size();
+}
+
+/**
+    @brief Closes a reader.
+
+    @param reader is the reader to close.
+
+    @return void.
+*/
+
+void close_reader(PackedReader& reader)
+{
+    if(reader.file.is_open()) reader.file.close();
+
+    reader.buffer.clear();
+    reader.index = 0;
+}
@@ -0,0 +1,205 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename packed_pos.h
+    @author Shreyas Vinod
+    @version 0.1.0
+
+    @brief Handles a compact, 32-byte binary encoding of positions.
+
+    Converts boards to and from a fixed size binary record holding the
+    occupancy bitboard, a 4-bit code for each occupied cell, the side to move,
+    castling permissions, the en passant square, counters and an optional
+    score and game result label. Records can be appended to and read from
+    files in bulk, for training data and evaluation tuning.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+*/
+
+/**
+    @file
+    @filename packed_pos.h
+    @author Shreyas Vinod
+
+    @brief Handles a compact, 32-byte binary encoding of positions.
+
+    Converts boards to and from a fixed size binary record holding the
+    occupancy bitboard, a 4-bit code for each occupied cell, the side to move,
+    castling permissions, the en passant square, counters and an optional
+    score and game result label. Records can be appended to and read from
+    files in bulk, for training data and evaluation tuning.
+*/
+
+#ifndef PACKED_POS_H
+#define PACKED_POS_H
+
+#include "defs.h"
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <fstream> // std::ifstream and std::ofstream
+
+#include "board.h"
+
+// Macros
+
+#define PACKED_BUFFER 4096 // Records buffered by packed streams.
+
+// Enumerations
+
+enum { RESULT_LOSS = -1, RESULT_DRAW, RESULT_WIN }; // Game results.
+
+enum { PK_SIDE = 0x1, PK_LABELLED = 0x20 }; // Packed state flags.
+
+// Structures
+
+/**
+    @struct PackedPos
+
+    @brief A position packed into 32 bytes.
+
+    @var PackedPos::occupancy
+         Bitboard of all occupied cells.
+    @var PackedPos::pieces
+         The piece type, in standard convention, of each occupied cell as a
+         4-bit code, in LERF order of the cells. The low nibble of each byte
+         comes first.
+    @var PackedPos::state
+         The side to move (PK_SIDE, set if white), castling permissions
+         (bits 1 to 4) and whether the record is labelled (PK_LABELLED).
+    @var PackedPos::en_pas_sq
+         The en passant square, or 'NO_SQ' (64).
+    @var PackedPos::fifty
+         The fifty-move rule counter.
+    @var PackedPos::result
+         The result of the game the position was taken from, from the point
+         of view of the side to move; RESULT_LOSS, RESULT_DRAW or RESULT_WIN.
+    @var PackedPos::move_num
+         The full move number.
+    @var PackedPos::score
+         The search score of the position, from the point of view of the side
+         to move.
+
+    @warning 'result' and 'score' only hold meaning if PK_LABELLED is set.
+    @warning Records are stored in host byte order, so files are only
+             portable between little-endian machines.
+*/
+
+struct PackedPos
+{
+    uint64 occupancy;
+    unsigned char pieces[16];
+    unsigned char state;
+    unsigned char en_pas_sq;
+    unsigned char fifty;
+    signed char result;
+    unsigned short move_num;
+    short score;
+
+    PackedPos()
+    :occupancy(0ULL), pieces(), state(0), en_pas_sq(NO_SQ), fifty(0),
+        result(RESULT_DRAW), move_num(1), score(0)
+    {}
+};
+
+static_assert(sizeof(PackedPos) == 32, "PackedPos must be 32 bytes.");
+
+/**
+    @struct PackedWriter
+
+    @brief Appends packed positions to a file, through a buffer.
+
+    @var PackedWriter::file
+         The output file.
+    @var PackedWriter::buffer
+         Records waiting to be written.
+    @var PackedWriter::count
+         The number of records appended so far.
+*/
+
+struct PackedWriter
+{
+    std::ofstream file;
+    std::vector<PackedPos> buffer;
+    uint64 count;
+
+    PackedWriter()
+    :file(), buffer(), count(0)
+    {}
+};
+
+/**
+    @struct PackedReader
+
+    @brief Reads packed positions from a file, through a buffer.
+
+    @var PackedReader::file
+         The input file.
+    @var PackedReader::buffer
+         Records read ahead from the file.
+    @var PackedReader::index
+         The index of the next record in 'buffer'.
+    @var PackedReader::count
+         The number of records read so far.
+*/
+
+struct PackedReader
+{
+    std::ifstream file;
+    std::vector<PackedPos> buffer;
+    unsigned int index;
+    uint64 count;
+
+    PackedReader()
+    :file(), buffer(), index(0), count(0)
+    {}
+};
+
+// External function declarations
+
+// Pack a board.
+
+extern void pack_board(const Board& board, PackedPos& packed);
+
+// Initialise a board from a packed position.
+
+extern bool unpack_board(Board& board, const PackedPos& packed);
+
+// Attach a score and game result to a packed position.
+
+extern void label_packed(PackedPos& packed, int score, int result);
+
+// Open a file to append packed positions to.
+
+extern bool open_writer(PackedWriter& writer, const std::string& path,
+    bool append);
+
+// Append a packed position.
+
+extern void write_packed(PackedWriter& writer, const PackedPos& packed);
+
+// Append many packed positions at once.
+
+extern void write_packed(PackedWriter& writer,
+    const std::vector<PackedPos>& packed);
+
+extern void flush_writer(PackedWriter& writer); // Write out the buffer.
+extern void close_writer(PackedWriter& writer); // Flush and close.
+
+// Open a file of packed positions.
+
+extern bool open_reader(PackedReader& reader, const std::string& path);
+
+// Read the next packed position.
+
+extern bool read_packed(PackedReader& reader, PackedPos& packed);
+
+// Read up to 'max' packed positions at once.
+
+extern unsigned int read_packed(PackedReader& reader,
+    std::vector<PackedPos>& packed, unsigned int max);
+
+extern void close_reader(PackedReader& reader); // Close the file.
+
+#endif // PACKED_POS_H
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename search.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.22
 
     @brief The heart of the alpha-beta algorithm that makes computer
            chess possible.
@@ -20,6 +20,37 @@
     * 21/12/2015 0.1.5 Added aspiration windows.
     * 10/04/2016 0.1.6 Removed aspiration windows (buggy).
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added node limits, silent search and search results.
+    * 17/10/2026 1.0.2 Added SearchParams and parse_search_params().
+    * 17/10/2026 1.0.3 UCI 'info' output now has seldepth, mate scores, nps, hashfull and currmove.
+    * 17/10/2026 1.0.4 is_repetition() no longer reads before the start of the history.
+    * 17/10/2026 1.0.5 Only the iteration and 'bestmove' lines flush standard output.
+    * 17/10/2026 1.0.6 Added singular extensions and multi-cut pruning.
+        * Searches with an excluded move use their own table keys.
+    * 17/10/2026 1.0.7 Added internal iterative deepening and reductions for nodes without a hash move.
+    * 17/10/2026 1.0.8 Null move reductions now scale with depth and static evaluation.
+        * Deep cutoffs with only minor pieces left are verified.
+    * 17/10/2026 1.0.9 Added late move pruning and ProbCut.
+        * The static evaluation is now computed once per node and kept per ply.
+    * 17/10/2026 1.0.10 Quiescence search now probes and stores the table, orders the hash move first and uses delta pruning.
+    * 17/10/2026 1.0.11 Alpha-Beta and quiescence search are now fail-soft, and every node stores its result with the right bound.
+        * Iterative deepening stops short of MAX_DEPTH.
+    * 17/10/2026 1.0.12 The hash move is searched before moves are generated.
+    * 17/10/2026 1.0.13 The PV line is collected in a triangular PV table during search.
+        * The root and exact hash hits inside the window no longer cut off.
+    * 17/10/2026 1.0.14 Added a dedicated root search over a persistent list of root moves.
+        * Root moves are ordered by score, then by subtree node count.
+        * Added MultiPV, 'searchmoves' and a soft time limit scaled by best move stability.
+    * 17/10/2026 1.0.15 Upcoming repetitions raise alpha to a draw.
+    * 17/10/2026 1.0.16 alpha_beta() only generates evasions when in check.
+    * 17/10/2026 1.0.17 Alpha-Beta and quiescence search are now instantiated per node type.
+        * Added principal variation search.
+        * Null move pruning, ProbCut, late move pruning and internal iterative reductions only run at non-PV nodes.
+    * 17/10/2026 1.0.18 currmove output is flushed as it's written.
+    * 17/10/2026 1.0.19 Root moves that fail low are ordered by their last exact score.
+    * 17/10/2026 1.0.20 parse_search_params() range-checks every value with parse_uint().
+    * 17/10/2026 1.0.21 currmove lines are written at most every CURRMOVE_INTERVAL milliseconds.
+    * 17/10/2026 1.0.22 Late move pruning waits for a legal move to be searched.
 */
 
 /**
@@ -37,47 +68,77 @@
 #include "defs.h"
 
 #include <iostream> // std::cout
-#include <algorithm> // std::sort()
+#include <vector> // std::vector
+#include <algorithm> // std::sort(), std::stable_sort() and std::find()
 
 #include "search.h"
 #include "board.h"
 #include "move.h" // IS_CAP() and COORD_MOVE()
 #include "movegen.h"
 #include "evaluate.h"
+#include "hash.h" // EXCLUDED_HASH()
 #include "hash_table.h"
 #include "chronos.h" // Time and get_time_diff()
 #include "misc.h"
 
+// Enumerations
+
+/*
+    The types of interior nodes, so that work only PV nodes need and pruning
+    only non-PV nodes may use are compiled out where irrelevant. The root has
+    root_search() of its own.
+*/
+
+enum NodeType { NODE_PV, NODE_NON_PV };
+
 // Prototypes
 
 inline void check_up(SearchInfo& search_info);
 inline bool is_repetition(const Board& board);
 inline void clear_for_search(Board& board, SearchInfo& search_info);
-int quiescence(int alpha, int beta, Board& board, SearchInfo& search_info);
-int alpha_beta(int alpha, int beta, unsigned int depth, Board& board,
-    SearchInfo& search_info, bool do_null);
+inline std::string uci_score(int score);
+inline void update_pv(Board& board, unsigned int move);
+template<NodeType NT> int quiescence(int alpha, int beta, Board& board,
+    SearchInfo& search_info);
+template<NodeType NT> int alpha_beta(int alpha, int beta, unsigned int depth,
+    Board& board, SearchInfo& search_info);
+int root_search(int alpha, int beta, unsigned int depth, Board& board,
+    SearchInfo& search_info, std::vector<RootMove>& root_moves,
+    unsigned int pv_index);
+inline bool root_move_order(const RootMove& lhs, const RootMove& rhs);
 void search(Board& board, SearchInfo& search_info);
+bool parse_search_params(const std::string& list, SearchParams& params);
 
 // Function definitions
 
 /**
-    @brief Performs a check on whether the time for search has been
-           exhausted.
+    @brief Performs a check on whether the node or time budget for search has
+           been exhausted, and polls standard input if the search isn't
+           silent. Called once per node.
 
     @param search_info is the search information structure.
 
     return void.
+
+    @warning Limits are not enforced until the first iteration has completed.
 */
 
 inline void check_up(SearchInfo& search_info)
 {
+    if(search_info.completed_depth == 0) return;
+
+    if(search_info.nodes_set && search_info.nodes >= search_info.max_nodes)
+        search_info.stopped = 1;
+
+    if((search_info.nodes & 8191) != 0) return;
+
     if(search_info.time_set &&
         get_time_diff(search_info.start_time) >= search_info.move_time)
     {
         search_info.stopped = 1;
     }
 
-    read_input(search_info);
+    if(!search_info.silent) read_input(search_info);
 }
 
 /**
@@ -94,8 +155,14 @@ inline void check_up(SearchInfo& search_info)
 inline bool is_repetition(const Board& board)
 {
     int bound = board.his_ply - 1;
+    int start = board.his_ply - board.fifty;
+
+    // Positions set up from a FEN with a non-zero fifty-move counter have
+    // less history than the counter suggests.
 
-    for(int i = board.his_ply - board.fifty; i < bound; i++)
+    if(start < 0) start = 0;
+
+    for(int i = start; i < bound; i++)
         if(board.history.at(i).hash_key == board.hash_key) return 1;
 
     return 0;
@@ -129,11 +196,68 @@ inline void clear_for_search(Board& board, SearchInfo& search_info)
             board.search_killers[i][j] = 0;
     }
 
+    // Clear the excluded moves.
+
+    for(unsigned int i = 0; i < MAX_DEPTH; i++)
+        board.excluded[i] = NO_MOVE;
+
     board.ply = 0; // Reset the ply to zero.
 
     search_info.nodes = 0;
+    search_info.sel_depth = 0;
+    search_info.null_min_ply = 0;
     search_info.fh = 0;
     search_info.fhf = 0;
+
+    search_info.best_move = NO_MOVE;
+    search_info.ponder_move = NO_MOVE;
+    search_info.best_score = 0;
+    search_info.completed_depth = 0;
+    search_info.change_time = 0;
+    search_info.change_depth = 0;
+    search_info.currmove_time = 0;
+}
+
+/**
+    @brief Formats a score for UCI 'info' output, as 'cp <x>', or as
+           'mate <y>' in moves for mate scores.
+
+    @param score is the score, from the point of view of the side to move.
+
+    @return std::string holding the formatted score.
+*/
+
+inline std::string uci_score(int score)
+{
+    std::stringstream out;
+
+    if(score > IS_MATE) out << "mate " << (INFINITY_C - score + 1) / 2;
+    else if(score < -IS_MATE) out << "mate " << -(INFINITY_C + score) / 2;
+    else out << "cp " << score;
+
+    return out.str();
+}
+
+/**
+    @brief Makes 'move' followed by the line found below it the PV line of
+           the current ply in the triangular PV table.
+
+    @param board is the board the search is being made on.
+    @param move is the move that raised alpha at the current ply.
+
+    @return void.
+*/
+
+inline void update_pv(Board& board, unsigned int move)
+{
+    const unsigned int ply = board.ply;
+
+    board.pv_table[ply][ply] = move;
+
+    for(unsigned int i = ply + 1; i < board.pv_length[ply + 1]; i++)
+        board.pv_table[ply][i] = board.pv_table[ply + 1][i];
+
+    board.pv_length[ply] = board.pv_length[ply + 1];
 }
 
 /**
@@ -146,29 +270,69 @@ inline void clear_for_search(Board& board, SearchInfo& search_info)
     @param search_info is the search information structure.
 
     @return int value denoting the value of the best move for this state.
+
+    @warning Non-PV nodes must be searched with a null window.
 */
 
-int quiescence(int alpha, int beta, Board& board, SearchInfo& search_info)
+template<NodeType NT> int quiescence(int alpha, int beta, Board& board,
+    SearchInfo& search_info)
 {
-    if((search_info.nodes & 8191) == 0) check_up(search_info);
+    const bool pv_node = NT == NODE_PV;
+
+    assert(pv_node || beta - alpha == 1);
+
+    if(pv_node) board.pv_length[board.ply] = board.ply; // No captures in PV.
+
+    check_up(search_info);
 
     search_info.nodes++;
 
+    if(board.ply > search_info.sel_depth) search_info.sel_depth = board.ply;
+
     if((is_repetition(board) || board.fifty >= 100) && board.ply) return 0;
 
+    // If a repetition can be forced, the score is at least a draw.
+
+    if(search_info.params.cycle && alpha < 0 && board.ply &&
+        has_game_cycle(board, board.ply))
+    {
+        alpha = 0;
+        if(alpha >= beta) return alpha;
+    }
+
     if(board.ply >= MAX_DEPTH - 1) // Maximum depth.
     {
         return static_eval(board);
     }
 
-    int score = static_eval(board);
+    unsigned int pv_move = NO_MOVE;
+    int score;
 
-    if(score >= beta) return beta;
+    // Check if an entry exists in the transposition table, of any depth.
+    // As in alpha_beta(), PV nodes search exact hits inside the window.
 
-    if(score > alpha) alpha = score;
+    if(probe_table(board.t_table, board.ply, board.hash_key, 0, pv_move,
+        score, alpha, beta) && (!pv_node || score <= alpha || score >= beta))
+    {
+        return score;
+    }
 
-    score = -INFINITY_C;
+    int stand_pat = static_eval(board);
+
+    if(stand_pat >= beta)
+    {
+        store_entry(board.t_table, board.ply, board.hash_key, NO_MOVE,
+            stand_pat, 0, TFBETA);
+        return stand_pat;
+    }
 
+    int old_alpha = alpha;
+    int best_score = stand_pat;
+    if(stand_pat > alpha) alpha = stand_pat;
+
+    const SearchParams& params = search_info.params;
+
+    unsigned int best_move = NO_MOVE;
     unsigned int legal = 0; // Number of legal moves found.
 
     unsigned int list_move, list_size;
@@ -177,6 +341,20 @@ int quiescence(int alpha, int beta, Board& board, SearchInfo& search_info)
 
     list_size = ml.list.size();
 
+    // If a hash move was found, search it first.
+
+    if(pv_move != NO_MOVE)
+    {
+        for(unsigned int i = 0; i < list_size; i++)
+        {
+            if(ml.list.at(i).move == pv_move)
+            {
+                ml.list.at(i).score = 200000;
+                break;
+            }
+        }
+    }
+
     // Sort the move list based on scores.
 
     std::sort(ml.list.begin(), ml.list.end(),
@@ -186,13 +364,36 @@ int quiescence(int alpha, int beta, Board& board, SearchInfo& search_info)
     {
         list_move = ml.list.at(i).move;
 
+        // Delta pruning. Skip captures that cannot bring the evaluation up
+        // to alpha, even with a margin for positional gains.
+
+        if(params.delta)
+        {
+            int gain = PIECE_VALUES[CAPTURED(list_move)];
+
+            if(IS_PROM(list_move))
+                gain += PIECE_VALUES[PROMOTED(list_move)] - PIECE_VALUES[wP];
+
+            int futility = stand_pat + gain + int(params.delta_margin);
+
+            if(futility <= alpha)
+            {
+                if(futility > best_score) best_score = futility;
+                continue;
+            }
+        }
+
         if(!make_move(board, list_move)) continue;
         legal++;
 
-        score = -quiescence(-beta, -alpha, board, search_info);
+        score = -quiescence<NT>(-beta, -alpha, board, search_info);
 
         undo_move(board);
 
+        if(search_info.stopped) return 0;
+
+        if(score > best_score) best_score = score;
+
         if(score > alpha) // Alpha cutoff.
         {
             if(score >= beta) // Beta cutoff.
@@ -200,14 +401,29 @@ int quiescence(int alpha, int beta, Board& board, SearchInfo& search_info)
                 if(legal == 1) search_info.fhf++;
                 search_info.fh++;
 
-                return beta;
+                store_entry(board.t_table, board.ply, board.hash_key,
+                    list_move, score, 0, TFBETA);
+
+                return score;
             }
 
             alpha = score;
+            best_move = list_move;
         }
     }
 
-    return alpha;
+    if(alpha > old_alpha)
+    {
+        store_entry(board.t_table, board.ply, board.hash_key, best_move,
+            best_score, 0, TFEXACT);
+    }
+    else
+    {
+        store_entry(board.t_table, board.ply, board.hash_key, pv_move,
+            best_score, 0, TFALPHA);
+    }
+
+    return best_score;
 }
 
 /**
@@ -219,24 +435,43 @@ int quiescence(int alpha, int beta, Board& board, SearchInfo& search_info)
     @param depth is the depth to search to.
     @param board is the board to search on.
     @param search_info is the search information structure.
-    @param do_null denotes whether to use the null-move heuristic.
 
     @return int value denoting the score of the best move for this state.
+
+    @warning Non-PV nodes must be searched with a null window.
 */
 
-int alpha_beta(int alpha, int beta, unsigned int depth, Board& board,
-    SearchInfo& search_info, bool do_null)
+template<NodeType NT> int alpha_beta(int alpha, int beta, unsigned int depth,
+    Board& board, SearchInfo& search_info)
 {
-    if(depth == 0) return quiescence(alpha, beta, board, search_info);
+    const bool pv_node = NT == NODE_PV;
+
+    assert(pv_node || beta - alpha == 1);
+
+    if(depth == 0) return quiescence<NT>(alpha, beta, board, search_info);
 
-    if((search_info.nodes & 8191) == 0) check_up(search_info);
+    if(pv_node) board.pv_length[board.ply] = board.ply;
+
+    check_up(search_info);
 
     search_info.nodes++;
 
+    if(board.ply > search_info.sel_depth) search_info.sel_depth = board.ply;
+
     // Check if the board is a repetition.
 
     if((is_repetition(board) || board.fifty >= 100) && board.ply) return 0;
 
+    // Check if a repetition can be forced, or could have been by the
+    // opponent earlier in the search. If so, the score is at least a draw.
+
+    if(search_info.params.cycle && alpha < 0 && board.ply &&
+        has_game_cycle(board, board.ply))
+    {
+        alpha = 0;
+        if(alpha >= beta) return alpha;
+    }
+
     // Check if we've reached the maximum depth.
 
     if(board.ply >= MAX_DEPTH - 1) // Maximum depth.
@@ -253,86 +488,305 @@ int alpha_beta(int alpha, int beta, unsigned int depth, Board& board,
 
     bool in_check = is_sq_attacked(POP_BIT(king_bb), board.side, board);
 
-    if(in_check) depth++; // In-check search extension.
+    // In-check search extension.
+
+    if(in_check && search_info.params.check_ext) depth++;
 
     int score = -INFINITY_C;
     unsigned int pv_move = NO_MOVE;
 
-    // Check if an entry exists in the transposition table.
+    // A search with a move excluded has table entries of its own.
 
-    if(probe_table(board.t_table, board.ply, board.hash_key, depth, pv_move,
-        score, alpha, beta))
+    unsigned int excluded = board.excluded[board.ply];
+    uint64 tt_key = excluded == NO_MOVE ? board.hash_key :
+        EXCLUDED_HASH(board.hash_key, excluded);
+
+    // Check if an entry exists in the transposition table. At PV nodes, an
+    // exact score inside the window would cut the PV line short here, so
+    // such nodes are searched instead.
+
+    if(probe_table(board.t_table, board.ply, tt_key, depth, pv_move,
+        score, alpha, beta) && (!pv_node || score <= alpha || score >= beta))
     {
         return score;
     }
 
-    // Null move pruning (zugzwang positions still possible)
+    // Null move pruning, at non-PV nodes not reached by a null move. The
+    // reduction grows with depth and with how far the static evaluation is
+    // above beta. The side to move must have a piece other than pawns, and
+    // with only minor pieces left, where zugzwang is most likely, deep
+    // cutoffs are verified by a search without a null move at this ply.
+
+    const SearchParams& params = search_info.params;
+
+    uint64 majors, minors;
+
+    if(board.side == WHITE)
+    {
+        majors = board.chessboard[wQ] | board.chessboard[wR];
+        minors = board.chessboard[wN] | board.chessboard[wB];
+    }
+    else
+    {
+        majors = board.chessboard[bQ] | board.chessboard[bR];
+        minors = board.chessboard[bN] | board.chessboard[bB];
+    }
+
+    // The static evaluation, and whether it is better than two plies ago.
 
-    if(do_null && !in_check && depth >= 4 && board.ply &&
-        (board.chessboard[wQ] | board.chessboard[wR] |
-        board.chessboard[bQ] | board.chessboard[bR]))
+    int eval = in_check ? -INFINITY_C : static_eval(board);
+    board.static_evals[board.ply] = eval;
+
+    bool improving = board.ply < 2 || in_check ||
+        eval > board.static_evals[board.ply - 2];
+
+    if(!pv_node && excluded == NO_MOVE && params.null_move && !in_check &&
+        depth >= params.null_depth && board.ply >= search_info.null_min_ply &&
+        board.ply && board.history.back().move != NO_MOVE &&
+        (majors | minors) && eval >= beta)
     {
+        unsigned int reduction = params.null_reduction;
+
+        if(params.null_depth_div) reduction += depth / params.null_depth_div;
+
+        if(params.null_eval_div)
+        {
+            int eval_reduction = (eval - beta) / int(params.null_eval_div);
+            reduction += eval_reduction < 3 ? eval_reduction : 3;
+        }
+
+        unsigned int null_depth = depth > reduction ? depth - reduction : 0;
+
         make_null_move(board);
-        score = -alpha_beta(-beta, -beta + 1, depth - 4, board,
-            search_info, 0);
+        score = -alpha_beta<NODE_NON_PV>(-beta, -beta + 1, null_depth, board,
+            search_info);
         undo_null_move(board);
 
         if(search_info.stopped) return 0;
 
-        if(score >= beta && score < IS_MATE && score > -IS_MATE) return beta;
+        if(score >= beta && score < IS_MATE && score > -IS_MATE)
+        {
+            if(majors || depth < params.null_verify_depth) return score;
+
+            // Verification search.
+
+            unsigned int null_min_ply = search_info.null_min_ply;
+            search_info.null_min_ply = board.ply + 1;
+
+            score = alpha_beta<NODE_NON_PV>(beta - 1, beta, null_depth, board,
+                search_info);
+
+            search_info.null_min_ply = null_min_ply;
+
+            if(search_info.stopped) return 0;
+
+            if(score >= beta) return score;
+        }
+    }
+
+    // ProbCut. If a capture beats beta by a margin in a reduced search, the
+    // full search would almost certainly cut too. Captures are first tried
+    // in quiescence, which is cheap and filters out most of them.
+
+    if(!pv_node && params.probcut && !in_check && excluded == NO_MOVE &&
+        board.ply && depth >= params.probcut_depth &&
+        depth > params.probcut_reduction &&
+        beta < IS_MATE && beta > -IS_MATE)
+    {
+        int probcut_beta = beta + params.probcut_margin;
+
+        MoveList captures = gen_captures(board);
+
+        std::sort(captures.list.begin(), captures.list.end(),
+            [](const Move& lhs, const Move& rhs)
+            { return lhs.score > rhs.score; });
+
+        for(unsigned int i = 0; i < captures.list.size(); i++)
+        {
+            unsigned int capture = captures.list[i].move;
+
+            if(!make_move(board, capture)) continue;
+
+            score = -quiescence<NODE_NON_PV>(-probcut_beta, -probcut_beta + 1,
+                board, search_info);
+
+            if(score >= probcut_beta)
+            {
+                score = -alpha_beta<NODE_NON_PV>(-probcut_beta,
+                    -probcut_beta + 1, depth - params.probcut_reduction, board,
+                    search_info);
+            }
+
+            undo_move(board);
+
+            if(search_info.stopped) return 0;
+
+            if(score >= probcut_beta) return score;
+        }
+    }
+
+    // Without a hash move, ordering falls back to the heuristics. At PV
+    // nodes, a shallower search finds a move to try first (internal
+    // iterative deepening); elsewhere the node is not worth the full depth
+    // and is searched a ply shallower (internal iterative reduction).
+
+    if(pv_move == NO_MOVE && excluded == NO_MOVE && board.ply)
+    {
+        if(pv_node && params.iid && depth >= params.iid_depth &&
+            depth > params.iid_reduction)
+        {
+            alpha_beta<NT>(alpha, beta, depth - params.iid_reduction, board,
+                search_info);
+
+            if(search_info.stopped) return 0;
+
+            pv_move = probe_pv_table(board.t_table, tt_key);
+        }
+        else if(!pv_node && params.iir && depth >= params.iir_depth) depth--;
     }
 
-    // Alpha-Beta!
+    // Alpha-Beta! Searches made at this ply so far may have left a PV line
+    // behind.
+
+    if(pv_node) board.pv_length[board.ply] = board.ply;
 
     unsigned int best_move = NO_MOVE;
+    int best_score = -INFINITY_C;
     score = -INFINITY_C;
 
     int old_alpha = alpha;
     unsigned int legal = 0; // Number of legal moves found.
+    unsigned int quiets = 0; // Number of quiet moves searched.
 
     unsigned int list_move, list_size;
 
-    MoveList ml = gen_moves(board);
+    // A pseudo-legal hash move is searched before any moves are generated,
+    // so that generation is skipped entirely when it causes a cutoff.
 
-    list_size = ml.list.size();
+    bool hash_first = pv_move != NO_MOVE && pv_move != excluded &&
+        is_pseudo_legal(board, pv_move);
+    bool generated = 0;
 
-    // If a PV line was found, find the PV move and increase its score.
+    MoveList ml;
 
-    if(pv_move != NO_MOVE)
+    if(hash_first) ml.list.push_back(Move(pv_move, 200000));
+
+    list_size = ml.list.size();
+
+    // Singular extension. If the hash move has a good enough score from a
+    // deep enough search, search every other move to a reduced depth against
+    // a bound just below it. If they all fail low, the hash move is singular
+    // and is extended by a ply. If they fail high too and the bound is above
+    // beta, several moves would cut, so the node is pruned (multi-cut).
+
+    unsigned int singular_move = NO_MOVE;
+    TableEntry entry;
+
+    if(params.singular_ext && excluded == NO_MOVE && pv_move != NO_MOVE &&
+        board.ply && depth >= params.singular_depth &&
+        board.ply < 2 * (search_info.completed_depth + 1) &&
+        probe_entry(board.t_table, board.ply, board.hash_key, entry) &&
+        entry.move == pv_move && entry.depth + 3 >= depth &&
+        (entry.flag == TFEXACT || entry.flag == TFBETA) &&
+        entry.score < IS_MATE && entry.score > -IS_MATE)
     {
-        for(unsigned int i = 0; i < list_size; i++)
-        {
-            list_move = ml.list.at(i).move;
+        int singular_beta = entry.score - params.singular_margin * depth;
 
-            if(pv_move == ml.list.at(i).move)
-            {
-                ml.list.at(i).score = 200000;
-                break;
-            }
-        }
-    }
+        board.excluded[board.ply] = pv_move;
+        score = alpha_beta<NODE_NON_PV>(singular_beta - 1, singular_beta,
+            (depth - 1) / 2, board, search_info);
+        board.excluded[board.ply] = NO_MOVE;
 
-    // Sort the move list based on scores.
+        if(search_info.stopped) return 0;
 
-    std::sort(ml.list.begin(), ml.list.end(),
-        [](const Move& lhs, const Move& rhs){ return lhs.score > rhs.score; });
+        if(score < singular_beta) singular_move = pv_move;
+        else if(singular_beta >= beta) return singular_beta; // Multi-cut.
+
+        score = -INFINITY_C;
+    }
 
     // Loop over every move.
 
-    for(unsigned int i = 0; i < list_size; i++)
+    for(unsigned int i = 0; ; i++)
     {
+        // Generate the remaining moves once the hash move has been searched,
+        // and sort them based on scores. In check, only evasions are needed.
+
+        if(i == list_size)
+        {
+            if(generated) break;
+
+            MoveList gen_ml = in_check ? gen_evasions(board) : gen_moves(board);
+
+            std::sort(gen_ml.list.begin(), gen_ml.list.end(),
+                [](const Move& lhs, const Move& rhs)
+                { return lhs.score > rhs.score; });
+
+            ml.list.insert(ml.list.end(), gen_ml.list.begin(),
+                gen_ml.list.end());
+
+            list_size = ml.list.size();
+            generated = 1;
+
+            if(i == list_size) break;
+        }
+
         list_move = ml.list.at(i).move;
 
+        if(list_move == excluded || (hash_first && i && list_move == pv_move))
+            continue;
+
+        // Late move pruning. At shallow non-PV nodes, once enough quiet moves
+        // have been searched, the remaining ones are unlikely to matter, all
+        // the more so when the position is not improving. Nothing is pruned
+        // before a legal move has been searched, or a node whose moves were
+        // all pruned would be scored as if it had none.
+
+        bool quiet = !IS_CAP(list_move) && !IS_PROM(list_move);
+
+        if(params.lmp && quiet && legal && !pv_node && !in_check &&
+            board.ply && depth <= params.lmp_depth && quiets >=
+            (params.lmp_base + depth * depth) / (improving ? 1 : 2) &&
+            list_move != board.search_killers[0][board.ply] &&
+            list_move != board.search_killers[1][board.ply])
+        {
+            continue;
+        }
+
         if(!make_move(board, list_move)) continue;
         legal++;
+        if(quiet) quiets++;
 
-        score = -alpha_beta(-beta, -alpha, depth - 1, board,
-            search_info, 1);
+        // Principal variation search. At PV nodes, the first move is searched
+        // with the full window, and every later one with a null window, to
+        // prove it no better than alpha. Moves that are better after all are
+        // searched again as PV nodes, with the full window.
+
+        unsigned int new_depth = depth - (list_move == singular_move ? 0 : 1);
+
+        if(pv_node && legal == 1)
+        {
+            score = -alpha_beta<NODE_PV>(-beta, -alpha, new_depth, board,
+                search_info);
+        }
+        else
+        {
+            score = -alpha_beta<NODE_NON_PV>(-alpha - 1, -alpha, new_depth,
+                board, search_info);
+
+            if(pv_node && score > alpha && score < beta)
+            {
+                score = -alpha_beta<NODE_PV>(-beta, -alpha, new_depth, board,
+                    search_info);
+            }
+        }
 
         undo_move(board);
 
         if(search_info.stopped == 1) return 0;
 
+        if(score > best_score) best_score = score;
+
         if(score > alpha) // Alpha cutoff.
         {
             if(score >= beta) // Beta cutoff.
@@ -350,19 +804,17 @@ int alpha_beta(int alpha, int beta, unsigned int depth, Board& board,
                     board.search_killers[0][board.ply] = list_move;
                 }
 
-                /********** BUGGY CODE **********/
-                /*
-                store_entry(board.t_table, board.ply, board.hash_key, list_move,
-                    beta, depth, TFBETA);
-                */
-                /********************************/
+                store_entry(board.t_table, board.ply, tt_key, list_move,
+                    score, depth, TFBETA);
 
-                return beta;
+                return score;
             }
 
             alpha = score;
             best_move = list_move;
 
+            if(pv_node) update_pv(board, list_move);
+
             // History heuristic.
 
             if(!IS_CAP(best_move))
@@ -386,31 +838,163 @@ int alpha_beta(int alpha, int beta, unsigned int depth, Board& board,
 
     if(legal == 0)
     {
-        if(in_check) return -INFINITY_C + board.ply; // Checkmate
+        if(excluded != NO_MOVE) return alpha; // Only the excluded move.
+        else if(in_check) return -INFINITY_C + board.ply; // Checkmate
         else return 0; // Stalemate
     }
 
-    // Check if we improved alpha.
+    // Check if we improved alpha. If not, the score is only an upper bound,
+    // and the hash move, if any, is kept for move ordering.
 
     assert(alpha >= old_alpha);
 
     if(alpha != old_alpha)
     {
-        store_entry(board.t_table, board.ply, board.hash_key, best_move,
-            alpha, depth, TFEXACT);
+        store_entry(board.t_table, board.ply, tt_key, best_move,
+            best_score, depth, TFEXACT);
     }
-
-    /********** BUGGY CODE **********/
-    /*
     else
     {
-        store_entry(board.t_table, board.ply, board.hash_key, best_move,
-            alpha, depth, TFALPHA);
+        store_entry(board.t_table, board.ply, tt_key, pv_move,
+            best_score, depth, TFALPHA);
+    }
+
+    return best_score;
+}
+
+/**
+    @brief Searches the root moves from 'pv_index' onwards. Unlike interior
+           nodes, the root keeps its moves in a list that persists across
+           iterations, recording each move's score, PV line and subtree node
+           count.
+
+    @param alpha refers to the current value of alpha.
+    @param beta refers to the current value of beta.
+    @param depth is the depth to search to.
+    @param board is the board to search on.
+    @param search_info is the search information structure.
+    @param root_moves is the list of root moves.
+    @param pv_index is the index of the first move to search. Moves before it
+           are the better lines already found in MultiPV mode.
+
+    @return int value denoting the score of the best move searched.
+
+    @warning Every move in 'root_moves' must be legal.
+*/
+
+int root_search(int alpha, int beta, unsigned int depth, Board& board,
+    SearchInfo& search_info, std::vector<RootMove>& root_moves,
+    unsigned int pv_index)
+{
+    assert(board.ply == 0);
+
+    check_up(search_info);
+
+    search_info.nodes++;
+
+    bool in_check = is_in_check(board);
+
+    // In-check search extension.
+
+    if(in_check && search_info.params.check_ext) depth++;
+
+    // The static evaluation, which the nodes two plies down compare theirs
+    // with.
+
+    board.static_evals[0] = in_check ? -INFINITY_C : static_eval(board);
+
+    int score, best_score = -INFINITY_C;
+
+    for(unsigned int i = pv_index; i < root_moves.size(); i++)
+    {
+        RootMove& root_move = root_moves[i];
+        uint64 nodes = search_info.nodes;
+
+        make_move(board, root_move.move);
+
+        // Report the root move being searched, once the search has run for
+        // long enough to make it worthwhile, and no more often than every
+        // CURRMOVE_INTERVAL milliseconds after that.
+
+        uint64 time = search_info.silent ? 0 :
+            get_time_diff(search_info.start_time);
+
+        if(time >= CURRMOVE_DELAY &&
+            time >= search_info.currmove_time + CURRMOVE_INTERVAL)
+        {
+            search_info.currmove_time = time;
+
+            std::cout << "info depth " << depth << " currmove " <<
+                COORD_MOVE(root_move.move) << " currmovenumber " << i + 1 <<
+                std::endl; // Flushed, so that the GUI sees it during search.
+        }
+
+        // Principal variation search, as in alpha_beta().
+
+        if(i == pv_index)
+        {
+            score = -alpha_beta<NODE_PV>(-beta, -alpha, depth - 1, board,
+                search_info);
+        }
+        else
+        {
+            score = -alpha_beta<NODE_NON_PV>(-alpha - 1, -alpha, depth - 1,
+                board, search_info);
+
+            if(score > alpha && score < beta)
+            {
+                score = -alpha_beta<NODE_PV>(-beta, -alpha, depth - 1, board,
+                    search_info);
+            }
+        }
+
+        undo_move(board);
+
+        root_move.nodes += search_info.nodes - nodes;
+
+        if(search_info.stopped) return 0;
+
+        if(score > best_score) best_score = score;
+
+        // Only moves that raise alpha have an exact score and a PV line.
+
+        if(score > alpha)
+        {
+            root_move.score = score;
+            root_move.pv.assign(1, root_move.move);
+
+            for(unsigned int j = 1; j < board.pv_length[1]; j++)
+                root_move.pv.push_back(board.pv_table[1][j]);
+
+            alpha = score;
+
+            if(score >= beta) break;
+        }
+        else root_move.score = -INFINITY_C;
     }
-    */
-    /********************************/
 
-    return alpha;
+    return best_score;
+}
+
+/**
+    @brief Orders root moves by score. Moves that failed low, whose scores
+           are unknown, are ordered by their last exact score from an earlier
+           iteration, and then by the size of their subtree.
+
+    @param lhs is the first root move.
+    @param rhs is the second root move.
+
+    @return bool denoting whether 'lhs' should be searched before 'rhs'.
+*/
+
+inline bool root_move_order(const RootMove& lhs, const RootMove& rhs)
+{
+    if(lhs.score != rhs.score) return lhs.score > rhs.score;
+
+    if(lhs.score == -INFINITY_C && lhs.prev_score != rhs.prev_score)
+        return lhs.prev_score > rhs.prev_score;
+
+    return lhs.nodes > rhs.nodes;
 }
 
 /**
@@ -425,48 +1009,160 @@ int alpha_beta(int alpha, int beta, unsigned int depth, Board& board,
 void search(Board& board, SearchInfo& search_info)
 {
     unsigned int best_move = NO_MOVE, ponder_move = NO_MOVE;
-    int best_score = -INFINITY_C;
-
-    unsigned int pv_moves; // Number of PV moves found.
 
     clear_for_search(board, search_info); // Get prepped for search.
 
-    for(unsigned int current_depth = 1; current_depth <= search_info.depth;
+    // Build the root move list, restricted to 'searchmoves' if given. Moves
+    // are ordered as they would be at any other node to begin with.
+
+    MoveList ml = gen_legal_moves(board);
+
+    std::sort(ml.list.begin(), ml.list.end(),
+        [](const Move& lhs, const Move& rhs){ return lhs.score > rhs.score; });
+
+    std::vector<RootMove> root_moves;
+
+    for(unsigned int i = 0; i < ml.list.size(); i++)
+    {
+        const std::vector<unsigned int>& only = search_info.search_moves;
+
+        if(only.empty() ||
+            std::find(only.begin(), only.end(), ml.list[i].move) != only.end())
+        {
+            root_moves.push_back(RootMove(ml.list[i].move));
+        }
+    }
+
+    if(root_moves.empty()) // None of the moves to search were legal.
+    {
+        for(unsigned int i = 0; i < ml.list.size(); i++)
+            root_moves.push_back(RootMove(ml.list[i].move));
+    }
+
+    unsigned int multi_pv = search_info.multi_pv;
+    if(multi_pv > root_moves.size()) multi_pv = root_moves.size();
+    if(multi_pv == 0) multi_pv = root_moves.empty() ? 0 : 1;
+
+    for(unsigned int current_depth = 1; current_depth <= search_info.depth &&
+        current_depth < MAX_DEPTH && !root_moves.empty();
         current_depth++) // Iterative deepening!
     {
-        best_score = alpha_beta(-INFINITY_C, INFINITY_C, current_depth,
-            board, search_info, 1); // Call Alpha-Beta and get the best score.
+        for(unsigned int i = 0; i < root_moves.size(); i++)
+        {
+            if(root_moves[i].score != -INFINITY_C)
+                root_moves[i].prev_score = root_moves[i].score;
+
+            root_moves[i].nodes = 0;
+        }
+
+        // Search each line of a MultiPV search in turn, every one over the
+        // moves that are not yet better lines, and order the rest for the
+        // next line and the next iteration.
+
+        for(unsigned int pv_index = 0; pv_index < multi_pv; pv_index++)
+        {
+            root_search(-INFINITY_C, INFINITY_C, current_depth, board,
+                search_info, root_moves, pv_index);
+
+            if(search_info.stopped) break;
+
+            std::stable_sort(root_moves.begin() + pv_index, root_moves.end(),
+                root_move_order);
+        }
 
         if(search_info.stopped) break; // Break out if search was interrupted.
 
+        std::stable_sort(root_moves.begin(), root_moves.begin() + multi_pv,
+            root_move_order);
+
         // Get the PV line.
 
-        pv_moves = probe_pv_line(board, current_depth); // Probe for PV line.
-        best_move = board.pv_array[0];
-        if(pv_moves > 1) ponder_move = board.pv_array[1];
-        else ponder_move = NO_MOVE;
+        const std::vector<unsigned int>& pv = root_moves[0].pv;
 
-        // Output some key information to standard output (in UCI format).
+        for(unsigned int i = 0; i < pv.size() && i < MAX_DEPTH; i++)
+            board.pv_array[i] = pv[i];
 
-        std::cout << "info score cp " << best_score << " depth " <<
-            current_depth << " nodes " << search_info.nodes << " time " <<
-            get_time_diff(search_info.start_time);
+        best_move = pv[0];
+        ponder_move = pv.size() > 1 ? pv[1] : unsigned(NO_MOVE);
 
-        std::cout << " pv";
+        // Record the results of the iteration.
 
-        for(unsigned int i = 0; i < pv_moves; i++)
+        if(best_move != search_info.best_move)
         {
-            std::cout << " " << COORD_MOVE(board.pv_array[i]);
+            search_info.change_time = get_time_diff(search_info.start_time);
+            search_info.change_depth = current_depth;
         }
 
-        std::cout << std::endl;
+        search_info.best_move = best_move;
+        search_info.ponder_move = ponder_move;
+        search_info.best_score = root_moves[0].score;
+        search_info.completed_depth = current_depth;
+
+        uint64 time = get_time_diff(search_info.start_time);
+
+        if(!search_info.silent)
+        {
+            // Output some key information to standard output (in UCI
+            // format), a line for each PV.
+
+            for(unsigned int i = 0; i < multi_pv; i++)
+            {
+                std::cout << "info depth " << current_depth << " seldepth " <<
+                    search_info.sel_depth;
+
+                if(multi_pv > 1) std::cout << " multipv " << i + 1;
+
+                std::cout << " score " << uci_score(root_moves[i].score) <<
+                    " nodes " << search_info.nodes << " nps " <<
+                    (search_info.nodes * 1000) / (time ? time : 1) <<
+                    " hashfull " << hash_full(board.t_table) << " time " <<
+                    time << " pv";
+
+                for(unsigned int j = 0; j < root_moves[i].pv.size(); j++)
+                    std::cout << " " << COORD_MOVE(root_moves[i].pv[j]);
+
+                std::cout << "\n";
+            }
+
+            std::cout << std::flush;
+
+            if(search_info.debug && search_info.fh > 0)
+            {
+                std::cout << "info string ordering " <<
+                    ((search_info.fhf / search_info.fh) * 100) << "%\n";
+            }
 
 #ifdef VERBOSE
-        std::cout << "ordering " <<
-            ((search_info.fhf / search_info.fh) * 100) << "%" << std::endl;
+            std::cout << "ordering " <<
+                ((search_info.fhf / search_info.fh) * 100) << "%" <<
+                std::endl;
 #endif // VERBOSE
+        }
+
+        // Time management. Don't start another iteration once the soft time
+        // limit is used up. The limit shrinks when the best move took most of
+        // the iteration's nodes, and grows when it changed in the last two
+        // iterations.
+
+        if(search_info.soft_time)
+        {
+            uint64 total = 0;
+
+            for(unsigned int i = 0; i < root_moves.size(); i++)
+                total += root_moves[i].nodes;
+
+            uint64 share = total ? (root_moves[0].nodes * 100) / total : 100;
+            uint64 limit = (search_info.soft_time * (150 - share)) / 100;
+
+            if(search_info.change_depth + 1 >= current_depth)
+                limit = (limit * 3) / 2;
+
+            if(time >= limit) break;
+        }
     }
 
+    if(search_info.silent) return;
+
     if(ponder_move != NO_MOVE)
     {
         std::cout << "bestmove " << COORD_MOVE(best_move) << " ponder " <<
@@ -477,3 +1173,76 @@ void search(Board& board, SearchInfo& search_info)
         std::cout << "bestmove " << COORD_MOVE(best_move) << std::endl;
     }
 }
+
+/**
+    @brief Sets search parameters from a comma separated list of
+           'name=value' pairs, such as "null_reduction=3,check_ext=0".
+
+    Switches must be 0 or 1, depths and reductions no more than MAX_DEPTH,
+    and margins and other values no more than INFINITY_C.
+
+    @param list is the list of parameters to set.
+    @param params is the search parameters to modify.
+
+    @return bool denoting whether every parameter was understood and in
+            range. Parameters before the first bad one are still set.
+*/
+
+bool parse_search_params(const std::string& list, SearchParams& params)
+{
+    std::stringstream pairs(list);
+    std::string pair, name;
+    uint64 value;
+
+    while(std::getline(pairs, pair, ','))
+    {
+        if(pair.empty()) continue;
+
+        std::size_t equals = pair.find('=');
+        if(equals == std::string::npos) return 0; // Parse error.
+
+        name = pair.substr(0, equals);
+
+        if(!parse_uint(pair.substr(equals + 1), INFINITY_C, value))
+            return 0; // Parse error.
+
+        bool flag = value <= 1, depth = value <= MAX_DEPTH;
+
+        if(name == "null_move" && flag) params.null_move = value;
+        else if(name == "null_depth" && depth) params.null_depth = value;
+        else if(name == "null_reduction" && depth)
+            params.null_reduction = value;
+        else if(name == "null_depth_div" && depth)
+            params.null_depth_div = value;
+        else if(name == "null_eval_div") params.null_eval_div = value;
+        else if(name == "null_verify_depth" && depth)
+            params.null_verify_depth = value;
+        else if(name == "check_ext" && flag) params.check_ext = value;
+        else if(name == "singular_ext" && flag) params.singular_ext = value;
+        else if(name == "singular_depth" && depth)
+            params.singular_depth = value;
+        else if(name == "singular_margin" && value <= INFINITY_C / MAX_DEPTH)
+            params.singular_margin = value; // Scaled by depth.
+        else if(name == "iid" && flag) params.iid = value;
+        else if(name == "iid_depth" && depth) params.iid_depth = value;
+        else if(name == "iid_reduction" && depth)
+            params.iid_reduction = value;
+        else if(name == "iir" && flag) params.iir = value;
+        else if(name == "iir_depth" && depth) params.iir_depth = value;
+        else if(name == "lmp" && flag) params.lmp = value;
+        else if(name == "lmp_depth" && depth) params.lmp_depth = value;
+        else if(name == "lmp_base") params.lmp_base = value;
+        else if(name == "probcut" && flag) params.probcut = value;
+        else if(name == "probcut_depth" && depth)
+            params.probcut_depth = value;
+        else if(name == "probcut_margin") params.probcut_margin = value;
+        else if(name == "probcut_reduction" && depth)
+            params.probcut_reduction = value;
+        else if(name == "delta" && flag) params.delta = value;
+        else if(name == "delta_margin") params.delta_margin = value;
+        else if(name == "cycle" && flag) params.cycle = value;
+        else return 0; // Unknown parameter, or out of range.
+    }
+
+    return 1;
+}
\ No newline at end of file
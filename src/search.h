@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename search.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.13
 
     @brief The heart of the alpha-beta algorithm that makes computer
            chess possible.
@@ -18,6 +18,19 @@
     * 06/12/2015 0.1.3 Added ponder move output during search.
     * 06/12/2015 0.1.4 Added in-check extensions.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added node limits, silent search and search results.
+    * 17/10/2026 1.0.2 Added SearchParams.
+    * 17/10/2026 1.0.3 Added seldepth and debug output.
+    * 17/10/2026 1.0.4 Added the singular extension parameters.
+    * 17/10/2026 1.0.5 Added the internal iterative deepening and reduction parameters.
+    * 17/10/2026 1.0.6 Added the adaptive null move parameters.
+    * 17/10/2026 1.0.7 Added the late move pruning and ProbCut parameters.
+    * 17/10/2026 1.0.8 Added the delta pruning parameters.
+    * 17/10/2026 1.0.9 Added RootMove, and the soft time limit, MultiPV and 'searchmoves' to SearchInfo.
+    * 17/10/2026 1.0.10 Added the upcoming repetition parameter.
+    * 17/10/2026 1.0.11 Added SearchInfo::null_min_ply.
+    * 17/10/2026 1.0.12 Added SearchInfo::interactive.
+    * 17/10/2026 1.0.13 Added CURRMOVE_INTERVAL and SearchInfo::currmove_time.
 */
 
 /**
@@ -37,11 +50,167 @@
 
 #include "defs.h"
 
+#include <vector> // std::vector
+
 #include "board.h"
 #include "chronos.h" // Time and get_time_diff()
 
+// Macros
+
+#define CURRMOVE_DELAY 1000 // Time before 'currmove' output in milliseconds.
+#define CURRMOVE_INTERVAL 250 // Time between 'currmove' lines in milliseconds.
+
 // Structures
 
+/**
+    @struct SearchParams
+
+    @brief Holds the tunable parameters of the search, so that differently
+           tuned searches can run side by side, as in an engine match.
+
+    @var SearchParams::null_move
+         Denotes whether null move pruning is enabled.
+    @var SearchParams::null_depth
+         The minimum depth at which a null move is tried.
+    @var SearchParams::null_reduction
+         The base depth reduction of the null move search.
+    @var SearchParams::null_depth_div
+         The null move reduction grows by a ply for every this many plies of
+         depth.
+    @var SearchParams::null_eval_div
+         The null move reduction grows by a ply for every this many
+         centipawns the static evaluation is above beta, by up to three
+         plies.
+    @var SearchParams::null_verify_depth
+         The minimum depth at which a null move cutoff is verified by a
+         reduced search without null moves, when the side to move has only
+         pawns and minor pieces and zugzwang is likely.
+    @var SearchParams::check_ext
+         Denotes whether in-check extensions are enabled.
+    @var SearchParams::singular_ext
+         Denotes whether singular extensions are enabled.
+    @var SearchParams::singular_depth
+         The minimum depth at which the hash move is tested for singularity.
+    @var SearchParams::singular_margin
+         The margin per ply of depth by which every other move must fall
+         short of the hash move's score for it to be singular.
+    @var SearchParams::iid
+         Denotes whether internal iterative deepening is enabled, where PV
+         nodes without a hash move run a shallower search to find one. Off
+         by default, since it grows the fixed-depth bench tree.
+    @var SearchParams::iid_depth
+         The minimum depth at which internal iterative deepening is used.
+    @var SearchParams::iid_reduction
+         The depth reduction of the internal iterative deepening search.
+    @var SearchParams::iir
+         Denotes whether internal iterative reductions are enabled, where
+         other nodes without a hash move are searched a ply shallower.
+    @var SearchParams::iir_depth
+         The minimum depth at which internal iterative reductions are used.
+    @var SearchParams::lmp
+         Denotes whether late move pruning is enabled, where quiet moves late
+         in the move list at shallow non-PV nodes are skipped.
+    @var SearchParams::lmp_depth
+         The maximum depth at which late move pruning is used.
+    @var SearchParams::lmp_base
+         The number of moves always searched before late move pruning,
+         besides the square of the depth. Halved when the static evaluation
+         is not improving over that of two plies earlier.
+    @var SearchParams::probcut
+         Denotes whether ProbCut is enabled, where a capture that beats
+         beta by a margin in a reduced search cuts the node early. Used only
+         at non-PV nodes, whose null window is what the cut is tested
+         against.
+    @var SearchParams::probcut_depth
+         The minimum depth at which ProbCut is used.
+    @var SearchParams::probcut_margin
+         The margin above beta that a capture must beat.
+    @var SearchParams::probcut_reduction
+         The depth reduction of the ProbCut search.
+    @var SearchParams::delta
+         Denotes whether delta pruning is enabled in quiescence search, where
+         captures that cannot raise the static evaluation to alpha even with
+         a margin are skipped.
+    @var SearchParams::delta_margin
+         The margin used by delta pruning.
+    @var SearchParams::cycle
+         Denotes whether upcoming repetitions are detected, so that a draw
+         can be claimed a ply before the position repeats.
+*/
+
+struct SearchParams
+{
+    bool null_move;
+    unsigned int null_depth;
+    unsigned int null_reduction;
+    unsigned int null_depth_div;
+    unsigned int null_eval_div;
+    unsigned int null_verify_depth;
+    bool check_ext;
+    bool singular_ext;
+    unsigned int singular_depth;
+    unsigned int singular_margin;
+    bool iid;
+    unsigned int iid_depth;
+    unsigned int iid_reduction;
+    bool iir;
+    unsigned int iir_depth;
+    bool lmp;
+    unsigned int lmp_depth;
+    unsigned int lmp_base;
+    bool probcut;
+    unsigned int probcut_depth;
+    unsigned int probcut_margin;
+    unsigned int probcut_reduction;
+    bool delta;
+    unsigned int delta_margin;
+    bool cycle;
+
+    SearchParams()
+    :null_move(1), null_depth(4), null_reduction(3), null_depth_div(4),
+        null_eval_div(300), null_verify_depth(8), check_ext(1),
+        singular_ext(1), singular_depth(8), singular_margin(2), iid(0),
+        iid_depth(5), iid_reduction(2), iir(1), iir_depth(4), lmp(1),
+        lmp_depth(3), lmp_base(3), probcut(1), probcut_depth(5),
+        probcut_margin(200), probcut_reduction(4), delta(1),
+        delta_margin(200), cycle(1)
+    {}
+};
+
+/**
+    @struct RootMove
+
+    @brief Holds a legal move at the root of the search, along with what
+           previous iterations learned about it.
+
+    @var RootMove::move
+         The move itself.
+    @var RootMove::score
+         The score from the current iteration, or -INFINITY_C if the move
+         failed low and only an upper bound is known.
+    @var RootMove::prev_score
+         The last exact score from an earlier iteration, or -INFINITY_C if
+         there is none. Orders moves that fail low.
+    @var RootMove::nodes
+         The number of nodes in the move's subtree in the last iteration.
+    @var RootMove::pv
+         The PV line starting with the move, if it was ever the best.
+*/
+
+struct RootMove
+{
+    unsigned int move;
+    int score;
+    int prev_score;
+    uint64 nodes;
+    std::vector<unsigned int> pv;
+
+    RootMove(unsigned int m)
+    :move(m), score(-INFINITY_C), prev_score(-INFINITY_C), nodes(0),
+        pv(1, m)
+    {}
+};
+
 /**
     @struct SearchInfo
 
@@ -51,48 +220,125 @@
          The time the search began.
     @var SearchInfo::move_time
          The maximum amount of time the search should take in milliseconds.
+    @var SearchInfo::soft_time
+         The time in milliseconds after which no new iteration is started,
+         scaled by how settled the best move is. Zero to always search up to
+         'move_time'.
     @var SearchInfo::depth
          The total depth to search to.
     @var SearchInfo::moves_to_go
          The number of moves to go, for time control.
     @var SearchInfo::nodes
          The number of nodes searched so far.
+    @var SearchInfo::max_nodes
+         The maximum number of nodes the search may visit.
     @var SearchInfo::depth_set
          Denotes whether a maximum depth has been set.
     @var SearchInfo::time_set
          Denotes whether maximum time has been set.
+    @var SearchInfo::nodes_set
+         Denotes whether a maximum number of nodes has been set.
+    @var SearchInfo::debug
+         Denotes whether to print extra debugging information, as set by the
+         UCI 'debug' command.
+    @var SearchInfo::silent
+         Denotes whether the search should run without printing UCI output
+         or polling standard input. Used by the batch modes, which run many
+         searches in parallel.
+    @var SearchInfo::interactive
+         Denotes whether any input stops the search, as in command line mode.
+         Otherwise, only 'stop' and 'quit' do, and other commands wait on the
+         queue until the search is over.
     @var SearchInfo::stopped
          Denotes whether an interrupt was acknowledged, where the search should
          be interrupted.
     @var SearchInfo::quit
          Denotes whether to quit the program.
+    @var SearchInfo::sel_depth
+         The greatest ply reached by the search, including quiescence.
+    @var SearchInfo::null_min_ply
+         The first ply at which null moves may be tried. Raised while a null
+         move cutoff is being verified.
     @var SearchInfo::fh
          Stands for 'fail-high', used for move ordering statistics.
     @var SearchInfo::fhf
          Stands for 'fail-high-first', used for move ordering statistics.
+    @var SearchInfo::best_move
+         The best move found by the last completed iteration.
+    @var SearchInfo::ponder_move
+         The expected reply to 'best_move', if any.
+    @var SearchInfo::best_score
+         The score of the last completed iteration.
+    @var SearchInfo::completed_depth
+         The depth of the last completed iteration.
+    @var SearchInfo::change_time
+         The time in milliseconds at which the iteration that last changed
+         'best_move' completed. Used to measure time-to-solution.
+    @var SearchInfo::change_depth
+         The depth of the iteration that last changed 'best_move'.
+    @var SearchInfo::currmove_time
+         The time in milliseconds at which the last 'currmove' line was
+         written, or zero if none was.
+    @var SearchInfo::multi_pv
+         The number of best lines to search and report.
+    @var SearchInfo::search_moves
+         The root moves to restrict the search to, as set by 'go
+         searchmoves'. Every move is searched if empty.
+    @var SearchInfo::params
+         The tunable parameters to search with.
+
+    @warning Node and time limits are only enforced once the first iteration
+             has completed, so that a search always yields a move.
 */
 
 struct SearchInfo
 {
     Time start_time;
     uint64 move_time;
+    uint64 soft_time;
 
     unsigned int depth;
     unsigned int moves_to_go;
 
     uint64 nodes;
+    uint64 max_nodes;
 
     bool depth_set;
     bool time_set;
+    bool nodes_set;
     bool stopped;
     bool quit;
+    bool silent;
+    bool interactive;
+    bool debug;
+
+    unsigned int sel_depth;
+    unsigned int null_min_ply;
 
     double fh;
     double fhf;
 
+    unsigned int best_move;
+    unsigned int ponder_move;
+    int best_score;
+    unsigned int completed_depth;
+    uint64 change_time;
+    unsigned int change_depth;
+    uint64 currmove_time;
+
+    unsigned int multi_pv;
+    std::vector<unsigned int> search_moves;
+
+    SearchParams params;
+
     SearchInfo()
-    :start_time(), move_time(0), depth(1), moves_to_go(0), nodes(0),
-        depth_set(0), time_set(0), stopped(0), quit(0), fh(0), fhf(0)
+    :start_time(), move_time(0), soft_time(0), depth(1), moves_to_go(0),
+        nodes(0), max_nodes(0), depth_set(0), time_set(0), nodes_set(0),
+        stopped(0), quit(0), silent(0), interactive(0), debug(0),
+        sel_depth(0),
+        null_min_ply(0), fh(0), fhf(0), best_move(0), ponder_move(0),
+        best_score(0), completed_depth(0), change_time(0), change_depth(0),
+        currmove_time(0), multi_pv(1), search_moves(), params()
     {}
 };
 
@@ -102,4 +348,8 @@ struct SearchInfo
 
 extern void search(Board& board, SearchInfo& search_info);
 
+// Set search parameters from a list such as "null_reduction=3,check_ext=0".
+
+extern bool parse_search_params(const std::string& list, SearchParams& params);
+
 #endif // SEARCH_H
\ No newline at end of file
@@ -0,0 +1,367 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename selfplay.cc
+    @author Shreyas Vinod
+    @version 0.1.3
+
+    @brief Generates labelled training positions through self-play.
+
+    Plays many games of the engine against itself at once, each starting with
+    a few random plies and then searched to a low fixed depth or node count.
+    Quiet positions are labelled with their search score and the final game
+    result, deduplicated by zobrist hash, and appended to a file of packed
+    positions.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 Game end checks moved to board.cc.
+    * 17/10/2026 0.1.2 Hash table allocation failures are reported.
+    * 17/10/2026 0.1.3 Fails if no thread can allocate its hash table.
+*/
+
+/**
+    @file
+    @filename selfplay.cc
+    @author Shreyas Vinod
+
+    @brief Generates labelled training positions through self-play.
+
+    Plays many games of the engine against itself at once, each starting with
+    a few random plies and then searched to a low fixed depth or node count.
+    Quiet positions are labelled with their search score and the final game
+    result, deduplicated by zobrist hash, and appended to a file of packed
+    positions.
+*/
+
+#include "defs.h"
+
+#include <iostream> // std::cout and std::cerr
+#include <string> // std::string
+#include <vector> // std::vector
+#include <thread> // std::thread
+#include <mutex> // std::mutex and std::lock_guard
+#include <atomic> // std::atomic
+#include <random> // std::mt19937_64
+
+#include "selfplay.h"
+#include "board.h"
+#include "move.h" // IS_CAP() and IS_PROM()
+#include "movegen.h" // gen_legal_moves()
+#include "search.h"
+#include "hash_table.h"
+#include "chronos.h" // Time and get_time_diff()
+#include "packed_pos.h"
+
+// Macros
+
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+// Structures
+
+/**
+    @struct SelfPlayShared
+
+    @brief Holds the state shared by all self-play threads.
+
+    @var SelfPlayShared::writer
+         The output file, guarded by 'write_lock'.
+    @var SelfPlayShared::write_lock
+         Serialises writes to 'writer' and progress output.
+    @var SelfPlayShared::seen
+         A lossy table of the zobrist hashes of recorded positions, indexed
+         by the low DEDUP_BITS bits of the hash.
+    @var SelfPlayShared::workers
+         The number of threads that could allocate their hash table, and so
+         took part.
+    @var SelfPlayShared::started
+         The number of games handed out to threads.
+    @var SelfPlayShared::finished
+         The number of games completed.
+    @var SelfPlayShared::positions
+         The number of positions written.
+    @var SelfPlayShared::duplicates
+         The number of positions dropped as duplicates.
+    @var SelfPlayShared::results
+         The number of black wins, draws and white wins, in that order.
+    @var SelfPlayShared::begin
+         The time the run started.
+*/
+
+struct SelfPlayShared
+{
+    PackedWriter writer;
+    std::mutex write_lock;
+    std::vector<std::atomic<uint64>> seen;
+    std::atomic<unsigned int> workers;
+    std::atomic<uint64> started;
+    std::atomic<uint64> finished;
+    std::atomic<uint64> positions;
+    std::atomic<uint64> duplicates;
+    std::atomic<uint64> results[3];
+    Time begin;
+
+    SelfPlayShared()
+    :writer(), write_lock(), seen(1ULL << DEDUP_BITS), workers(0),
+        started(0), finished(0), positions(0), duplicates(0), results(),
+        begin(get_cur_time())
+    {}
+};
+
+// Prototypes
+
+inline bool is_new_position(SelfPlayShared& shared, uint64 hash_key);
+void flush_positions(SelfPlayShared& shared, std::vector<PackedPos>& buffer);
+void selfplay_worker(SelfPlayShared& shared, const SelfPlayOptions& options,
+    unsigned int thread_id);
+bool gen_selfplay_data(const SelfPlayOptions& options);
+
+// Function definitions
+
+/**
+    @brief Checks whether a position has not been recorded before, and marks
+           it as recorded.
+
+    @param shared is the shared self-play state.
+    @param hash_key is the zobrist hash of the position.
+
+    @return bool denoting whether the position is new.
+
+    @warning The table is lossy: a position is only remembered until another
+             one with the same low DEDUP_BITS bits replaces it.
+*/
+
+inline bool is_new_position(SelfPlayShared& shared, uint64 hash_key)
+{
+    std::atomic<uint64>& slot =
+        shared.seen[hash_key & ((1ULL << DEDUP_BITS) - 1)];
+
+    return slot.exchange(hash_key, std::memory_order_relaxed) != hash_key;
+}
+
+/**
+    @brief Writes out a thread's buffered positions and empties the buffer.
+
+    @param shared is the shared self-play state.
+    @param buffer is the thread's buffer of labelled positions.
+
+    @return void.
+*/
+
+void flush_positions(SelfPlayShared& shared, std::vector<PackedPos>& buffer)
+{
+    std::lock_guard<std::mutex> lock(shared.write_lock);
+
+    write_packed(shared.writer, buffer);
+    shared.positions += buffer.size();
+    buffer.clear();
+}
+
+/**
+    @brief Self-play thread. Plays games until the shared game count runs
+           out, buffering the labelled positions of each game.
+
+    @param shared is the shared self-play state.
+    @param options is the self-play settings.
+    @param thread_id is the index of the thread, used to seed its random
+           number generator.
+
+    @return void.
+*/
+
+void selfplay_worker(SelfPlayShared& shared, const SelfPlayOptions& options,
+    unsigned int thread_id)
+{
+    Board board;
+
+    // A thread without a table plays no games, leaving them to the rest.
+
+    if(!init_table(board.t_table, options.hash_size))
+    {
+        std::cerr << "ERROR: Unable to allocate the hash table." << std::endl;
+        return;
+    }
+
+    shared.workers++;
+
+    std::mt19937_64 rng(options.seed + thread_id * 0x9e3779b97f4a7c15ULL);
+
+    std::vector<PackedPos> game, buffer;
+    std::vector<uint64> keys; // Zobrist hashes of the positions in 'game'.
+    buffer.reserve(PACKED_BUFFER);
+
+    unsigned int fen_index, move;
+    int score, result; // 'result' is from white's point of view.
+
+    while(shared.started++ < options.games)
+    {
+        fen_index = 0;
+        parse_fen(board, START_FEN, fen_index);
+        clear_table(board.t_table);
+
+        game.clear();
+        keys.clear();
+        result = RESULT_DRAW;
+
+        // Random opening
+
+        for(unsigned int i = 0; i < options.random_plies; i++)
+        {
+            MoveList ml = gen_legal_moves(board);
+            if(ml.list.empty()) break;
+
+            make_move(board, ml.list[rng() % ml.list.size()].move);
+        }
+
+        // Play the game out.
+
+        while(1)
+        {
+            if(gen_legal_moves(board).list.empty())
+            {
+                if(is_in_check(board))
+                    result = (board.side == WHITE) ? RESULT_LOSS : RESULT_WIN;
+                break;
+            }
+
+            if(is_drawn(board) || board.his_ply >= options.max_plies) break;
+
+            SearchInfo search_info;
+            search_info.silent = 1;
+            search_info.depth = MAX_DEPTH - 1;
+
+            if(options.depth)
+            {
+                search_info.depth_set = 1;
+                search_info.depth = options.depth;
+            }
+
+            if(options.nodes)
+            {
+                search_info.nodes_set = 1;
+                search_info.max_nodes = options.nodes;
+            }
+
+            search_info.start_time = get_cur_time();
+            search(board, search_info);
+
+            move = search_info.best_move;
+            score = search_info.best_score;
+
+            if(move == NO_MOVE) break;
+
+            if(score >= options.eval_limit || score <= -options.eval_limit)
+            {
+                result = ((score > 0) == (board.side == WHITE)) ?
+                    RESULT_WIN : RESULT_LOSS;
+                break;
+            }
+
+            // Only quiet positions are recorded.
+
+            if(!is_in_check(board) && !IS_CAP(move) && !IS_PROM(move))
+            {
+                PackedPos packed;
+                pack_board(board, packed);
+                label_packed(packed, score, RESULT_DRAW);
+
+                game.push_back(packed);
+                keys.push_back(board.hash_key);
+            }
+
+            make_move(board, move);
+        }
+
+        // Label the positions with the result and buffer the new ones.
+
+        for(unsigned int i = 0; i < game.size(); i++)
+        {
+            if(!is_new_position(shared, keys[i]))
+            {
+                shared.duplicates++;
+                continue;
+            }
+
+            game[i].result = (game[i].state & PK_SIDE) ? result : -result;
+            buffer.push_back(game[i]);
+        }
+
+        if(buffer.size() >= PACKED_BUFFER) flush_positions(shared, buffer);
+
+        shared.results[result + 1]++;
+
+        if(++shared.finished % 100 == 0)
+        {
+            std::lock_guard<std::mutex> lock(shared.write_lock);
+
+            std::cout << "Played " << shared.finished << " games, " <<
+                shared.positions << " positions written in " <<
+                get_time_diff(shared.begin) / 1000 << " s." << std::endl;
+        }
+    }
+
+    flush_positions(shared, buffer);
+    free_table(board.t_table);
+}
+
+/**
+    @brief Plays games of the engine against itself on a pool of threads and
+           appends the labelled positions to a file.
+
+    @param options is the self-play settings.
+
+    @return bool denoting whether the run took place, that is, whether the
+            output file could be opened and at least one thread could
+            allocate its hash table. No summary is printed otherwise.
+
+    @warning Each thread allocates its own transposition table of
+             'options.hash_size' bytes.
+*/
+
+bool gen_selfplay_data(const SelfPlayOptions& options)
+{
+    SelfPlayShared shared;
+
+    if(!open_writer(shared.writer, options.out_file, 1))
+    {
+        std::cerr << "ERROR: Unable to open output file \"" <<
+            options.out_file << "\"." << std::endl;
+        return 0;
+    }
+
+    SelfPlayOptions opts = options;
+
+    if(!opts.depth && !opts.nodes) opts.depth = 6;
+    if(opts.threads == 0) opts.threads = 1;
+
+    std::vector<std::thread> workers;
+
+    for(unsigned int i = 0; i < opts.threads; i++)
+    {
+        workers.push_back(std::thread(selfplay_worker, std::ref(shared),
+            std::cref(opts), i));
+    }
+
+    for(unsigned int i = 0; i < workers.size(); i++) workers.at(i).join();
+
+    close_writer(shared.writer);
+
+    // If no thread could start, no game was played.
+
+    if(options.games && shared.workers == 0) return 0;
+
+    uint64 time = get_time_diff(shared.begin);
+
+    std::cout << "Played " << shared.finished << " games (+" <<
+        shared.results[RESULT_WIN + 1] << " =" <<
+        shared.results[RESULT_DRAW + 1] << " -" <<
+        shared.results[RESULT_LOSS + 1] << " for white)." << std::endl;
+    std::cout << "Wrote " << shared.positions << " positions to \"" <<
+        opts.out_file << "\", dropping " << shared.duplicates <<
+        " duplicates." << std::endl;
+    std::cout << "It took " << time / 1000.0 << " s (" <<
+        (time ? (shared.positions * 3600000) / time : 0) <<
+        " positions per hour)." << std::endl;
+
+    return 1;
+}
@@ -0,0 +1,106 @@
+/*
+    Cortex - Self-learning Chess Engine
+    @filename selfplay.h
+    @author Shreyas Vinod
+    @version 0.1.1
+
+    @brief Generates labelled training positions through self-play.
+
+    Plays many games of the engine against itself at once, each starting with
+    a few random plies and then searched to a low fixed depth or node count.
+    Quiet positions are labelled with their search score and the final game
+    result, deduplicated by zobrist hash, and appended to a file of packed
+    positions.
+
+    ******************** VERSION CONTROL ********************
+    * 17/10/2026 File created.
+    * 17/10/2026 0.1.0 Initial version.
+    * 17/10/2026 0.1.1 SelfPlayOptions::hash_size is 64-bit.
+*/
+
+/**
+    @file
+    @filename selfplay.h
+    @author Shreyas Vinod
+
+    @brief Generates labelled training positions through self-play.
+
+    Plays many games of the engine against itself at once, each starting with
+    a few random plies and then searched to a low fixed depth or node count.
+    Quiet positions are labelled with their search score and the final game
+    result, deduplicated by zobrist hash, and appended to a file of packed
+    positions.
+*/
+
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include "defs.h"
+
+#include <string> // std::string
+
+// Macros
+
+#define DEDUP_BITS 22 // The deduplication table holds 2^DEDUP_BITS hashes.
+
+// Structures
+
+/**
+    @struct SelfPlayOptions
+
+    @brief Holds the settings for a self-play data generation run.
+
+    @var SelfPlayOptions::games
+         The number of games to play.
+    @var SelfPlayOptions::depth
+         The depth to search every move to, or zero if unlimited.
+    @var SelfPlayOptions::nodes
+         The node budget per move, or zero if unlimited.
+    @var SelfPlayOptions::random_plies
+         The number of random plies each game opens with. Positions from
+         the random opening are not recorded.
+    @var SelfPlayOptions::max_plies
+         The length in plies after which a game is adjudicated a draw.
+    @var SelfPlayOptions::eval_limit
+         The absolute score at which a game is adjudicated a win for the side
+         ahead.
+    @var SelfPlayOptions::threads
+         The number of games played at once.
+    @var SelfPlayOptions::hash_size
+         The size of each thread's transposition table in bytes.
+    @var SelfPlayOptions::seed
+         The seed for the random opening plies.
+    @var SelfPlayOptions::out_file
+         The file to append packed positions to.
+
+    @warning If neither a depth nor a node budget is set, every move is
+             searched to depth six.
+*/
+
+struct SelfPlayOptions
+{
+    uint64 games;
+    unsigned int depth;
+    uint64 nodes;
+    unsigned int random_plies;
+    unsigned int max_plies;
+    int eval_limit;
+    unsigned int threads;
+    uint64 hash_size;
+    uint64 seed;
+    std::string out_file;
+
+    SelfPlayOptions()
+    :games(1000), depth(0), nodes(0), random_plies(8), max_plies(400),
+        eval_limit(3000), threads(1), hash_size(16777216), seed(0),
+        out_file()
+    {}
+};
+
+// External function declarations
+
+// Generate labelled positions through self-play.
+
+extern bool gen_selfplay_data(const SelfPlayOptions& options);
+
+#endif // SELFPLAY_H
@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename uci.cc
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.10
 
     @brief Includes everything needed to support the UCI
            (Universal Chess Interface) protocol.
@@ -11,6 +11,20 @@
     * 02/12/2015 File created.
     * 02/12/2015 0.1.0 Initial version.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added 'go nodes <n>'.
+    * 17/10/2026 1.0.2 Added a typed option registry and 'setoption'.
+        * Options: Hash, Threads, Clear Hash, MultiPV and Move Overhead.
+        * 'Move Overhead' replaces the fixed 50 ms in parse_uci_go().
+        * Added 'uci' and 'ucinewgame'.
+    * 17/10/2026 1.0.3 Debug output is now behind 'debug on'.
+        * Removed the board dump after 'position'.
+    * 17/10/2026 1.0.4 'position ... moves' only makes the moves appended since the last command.
+    * 17/10/2026 1.0.5 Commands are read from the input queue, and output is flushed only at protocol boundaries.
+    * 17/10/2026 1.0.6 Added 'go searchmoves' and MultiPV, and a soft time limit under a clock.
+    * 17/10/2026 1.0.7 Added the 'Shared Hash' option, to share the transposition table between processes.
+    * 17/10/2026 1.0.8 'Move Overhead' is only taken off clock time, not a fixed 'movetime'.
+    * 17/10/2026 1.0.9 A 'Hash' size that can't be allocated is reported, and the previous table kept.
+    * 17/10/2026 1.0.10 'Clear Hash' and 'ucinewgame' report that a shared table is not cleared.
 */
 
 /**
@@ -27,51 +41,370 @@
 #include <iostream>
 #include <string> // std::string
 #include <sstream> // std::stringstream
+#include <vector> // std::vector
+#include <cctype> // tolower(), isspace()
+#include <algorithm> // std::equal()
 
 #include "uci.h"
 #include "board.h"
 #include "search.h"
 #include "hash_table.h"
 #include "chronos.h"
+#include "misc.h"
 
 #define FEN_START "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
 
+// Globals
+
+std::vector<UciOption> uci_options; // The option registry.
+bool uci_debug = 0; // Set with 'debug on', for extra 'info string' output.
+std::string uci_base; // The position part of the last 'position' command.
+std::vector<std::string> uci_moves; // The moves applied on top of uci_base.
+
 // Prototypes
 
-void uci_loop();
+void on_hash(const UciOption& option, Board& board);
+void on_shared_hash(const UciOption& option, Board& board);
+void on_clear_hash(const UciOption& option, Board& board);
+void clear_uci_table(Board& board);
+void init_uci_options(Board& board);
+void print_uci_id();
+UciOption* find_option(const std::string& name);
+int get_option(const std::string& name);
+bool parse_uci_setoption(const std::string& cmd, Board& board);
+void uci_loop(bool greet);
 bool parse_uci_position(const std::string& cmd, Board& board);
 void parse_uci_go(const std::string& cmd, SearchInfo& search_info,
     Board& board);
 
 // Function definitions
 
+/**
+    @brief Resizes the transposition table when the 'Hash' option changes.
+
+    If 'Shared Hash' names a segment, the table is attached to it instead,
+    falling back to a private table if that fails. If the memory can't be
+    allocated, the previous table is kept.
+
+    @param option is the option that changed.
+    @param board is the board holding the table.
+
+    @return void.
+*/
+
+void on_hash(const UciOption& option, Board& board)
+{
+    (void)option; // Unused; the size and name are read from the registry.
+
+    uint64 size = uint64(get_option("Hash")) * 1048576;
+    UciOption* shared = find_option("Shared Hash");
+
+    if(shared && !shared->str_value.empty())
+    {
+        if(init_shared_table(board.t_table, size, shared->str_value)) return;
+
+        std::cout << "info string cannot attach to shared hash '" <<
+            shared->str_value << "', using a private table\n";
+    }
+
+    if(init_table(board.t_table, size)) return;
+
+    // Keep the previous table, or fall back to a small one if there's none.
+
+    std::cout << "info string cannot allocate " << get_option("Hash") <<
+        " MB of hash, ";
+
+    if(board.t_table.t_entry) std::cout << "keeping the previous table\n";
+    else
+    {
+        init_table(board.t_table, 1048576);
+        std::cout << "using 1 MB\n";
+    }
+}
+
+/**
+    @brief Attaches the transposition table to the named shared memory
+           segment when the 'Shared Hash' option changes, or goes back to a
+           private table when it's emptied.
+
+    @param option is the 'Shared Hash' option.
+    @param board is the board holding the table.
+
+    @return void.
+*/
+
+void on_shared_hash(const UciOption& option, Board& board)
+{
+    // A private table that stays private needs no reallocation.
+
+    if(option.str_value.empty() && !board.t_table.map_size) return;
+
+    on_hash(option, board);
+}
+
+/**
+    @brief Empties the transposition table when the 'Clear Hash' button is
+           pressed.
+
+    @param option is the 'Clear Hash' option.
+    @param board is the board holding the table.
+
+    @return void.
+*/
+
+void on_clear_hash(const UciOption& option, Board& board)
+{
+    (void)option; // Unused.
+
+    clear_uci_table(board);
+}
+
+/**
+    @brief Empties the transposition table, or tells the GUI that it was
+           left alone because it's shared with other processes.
+
+    @param board is the board holding the table.
+
+    @return void.
+*/
+
+void clear_uci_table(Board& board)
+{
+    if(board.t_table.map_size)
+    {
+        std::cout << "info string shared hash not cleared, other " <<
+            "processes may be using it\n";
+        return;
+    }
+
+    clear_table(board.t_table);
+}
+
+/**
+    @brief Registers every option the engine supports, sets them to their
+           defaults and applies them.
+
+    To support a new option, register it here, and either give it an
+    'on_change' handler or read it with get_option() where it's needed.
+
+    @param board is the board of the UCI loop.
+
+    @return void.
+
+    @warning Search is single-threaded, so 'Threads' is fixed at one for now.
+*/
+
+void init_uci_options(Board& board)
+{
+    uci_options.clear();
+
+    uci_options.push_back(UciOption("Hash", OPT_SPIN, 256, 1, 32768, "",
+        on_hash));
+    uci_options.push_back(UciOption("Threads", OPT_SPIN, 1, 1, 1, "",
+        nullptr));
+    uci_options.push_back(UciOption("Clear Hash", OPT_BUTTON, 0, 0, 0, "",
+        on_clear_hash));
+    uci_options.push_back(UciOption("MultiPV", OPT_SPIN, 1, 1, 256, "",
+        nullptr));
+    uci_options.push_back(UciOption("Move Overhead", OPT_SPIN, 50, 0, 5000,
+        "", nullptr));
+    uci_options.push_back(UciOption("Shared Hash", OPT_STRING, 0, 0, 0, "",
+        on_shared_hash));
+
+    for(unsigned int i = 0; i < uci_options.size(); i++)
+    {
+        if(uci_options[i].on_change && uci_options[i].type != OPT_BUTTON)
+            uci_options[i].on_change(uci_options[i], board);
+    }
+}
+
+/**
+    @brief Prints the engine's identity and options, followed by 'uciok', in
+           reply to the UCI 'uci' command.
+
+    @return void.
+*/
+
+void print_uci_id()
+{
+    std::cout << "id name Cortex\n";
+    std::cout << "id author Shreyas Vinod, Anna Grygierzec\n";
+
+    for(unsigned int i = 0; i < uci_options.size(); i++)
+    {
+        const UciOption& option = uci_options[i];
+
+        std::cout << "option name " << option.name << " type ";
+
+        switch(option.type)
+        {
+            case OPT_SPIN:
+                std::cout << "spin default " << option.def << " min " <<
+                    option.min << " max " << option.max;
+                break;
+            case OPT_CHECK:
+                std::cout << "check default " <<
+                    (option.def ? "true" : "false");
+                break;
+            case OPT_BUTTON: std::cout << "button"; break;
+            case OPT_STRING:
+                std::cout << "string default " <<
+                    (option.str_def.empty() ? "<empty>" : option.str_def);
+                break;
+            default: break;
+        }
+
+        std::cout << "\n";
+    }
+
+    std::cout << "uciok" << std::endl;
+}
+
+/**
+    @brief Finds an option by name. Names are compared case-insensitively,
+           as the UCI protocol requires.
+
+    @param name is the name of the option.
+
+    @return UciOption* pointing to the option, or null if there's none.
+*/
+
+UciOption* find_option(const std::string& name)
+{
+    for(unsigned int i = 0; i < uci_options.size(); i++)
+    {
+        const std::string& option_name = uci_options[i].name;
+
+        if(option_name.length() != name.length()) continue;
+
+        unsigned int j = 0;
+
+        while(j < name.length() &&
+            tolower(option_name[j]) == tolower(name[j])) j++;
+
+        if(j == name.length()) return &uci_options[i];
+    }
+
+    return nullptr;
+}
+
+/**
+    @brief Gets the value of a spin or check option.
+
+    @param name is the name of the option.
+
+    @return int holding the value of the option, or zero if there's no such
+            option.
+*/
+
+int get_option(const std::string& name)
+{
+    UciOption* option = find_option(name);
+
+    return option ? option->value : 0;
+}
+
+/**
+    @brief Parses the UCI 'setoption' command, of the form
+           'setoption name <id> [value <x>]', and applies the option.
+
+    @param cmd is the string that was received from the GUI.
+    @param board is the board of the UCI loop.
+
+    @return bool denoting whether the option exists and the value was valid.
+
+    @warning Spin values out of range are clamped.
+*/
+
+bool parse_uci_setoption(const std::string& cmd, Board& board)
+{
+    std::size_t name_pos = cmd.find(" name ");
+    if(name_pos == std::string::npos) return 0; // Parse error.
+
+    std::size_t value_pos = cmd.find(" value ", name_pos);
+    std::string name, value;
+
+    if(value_pos == std::string::npos) name = cmd.substr(name_pos + 6);
+    else
+    {
+        name = cmd.substr(name_pos + 6, value_pos - name_pos - 6);
+        value = cmd.substr(value_pos + 7);
+    }
+
+    // Trim surrounding whitespace.
+
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t\r") + 1);
+    value.erase(0, value.find_first_not_of(" \t"));
+    value.erase(value.find_last_not_of(" \t\r") + 1);
+
+    UciOption* option = find_option(name);
+    if(!option) return 0; // No such option.
+
+    switch(option->type)
+    {
+        case OPT_SPIN:
+        {
+            bool negative = !value.empty() && value[0] == '-';
+            std::string digits = value.substr(negative);
+
+            if(digits.empty() || digits.length() > 9 ||
+                digits.find_first_not_of("0123456789") != std::string::npos)
+                return 0; // Parse error.
+
+            int number = std::stoi(digits) * (negative ? -1 : 1);
+
+            if(number < option->min) number = option->min;
+            if(number > option->max) number = option->max;
+
+            option->value = number;
+            break;
+        }
+        case OPT_CHECK:
+            if(value == "true") option->value = 1;
+            else if(value == "false") option->value = 0;
+            else return 0; // Parse error.
+            break;
+        case OPT_STRING:
+            option->str_value = (value == "<empty>") ? "" : value;
+            break;
+        case OPT_BUTTON: break;
+        default: return 0;
+    }
+
+    if(option->on_change) option->on_change(*option, board);
+
+    return 1;
+}
+
 /**
     @brief UCI infinite loop to listen for commands from UCI protocol
            enabled graphical interfaces.
 
+    @param greet denotes whether to reply to a 'uci' command that was read
+           before entering the loop.
+
     @return void.
 */
 
-void uci_loop()
+void uci_loop(bool greet)
 {
     std::string cmd; // Stores any commands from the GUI.
 
-    std::cout << "id name Cortex" << std::endl;
-    std::cout << "id author Shreyas Vinod, Anna Grygierzec" << std::endl;
-    std::cout << "uciok" << std::endl;
-
     Board board;
-    init_table(board.t_table, 268435456); // Initialise hash table to 256 MB.
+    init_uci_options(board); // Also sizes the hash table.
+
+    if(greet) print_uci_id();
 
     SearchInfo search_info;
 
+    start_input();
+
     while(1)
     {
-        std::cin.clear();
-        std::cin.sync();
-        std::getline(std::cin, cmd);
+        next_input(cmd, 1);
 
-        if(cmd == "\n") continue;
+        if(cmd.empty()) continue;
 
         if(cmd.compare(0, 2, "go") == 0)
         {
@@ -81,6 +414,20 @@ void uci_loop()
         {
             if(!parse_uci_position(cmd, board)) return; // Fatal error.
         }
+        else if(cmd.compare(0, 9, "setoption") == 0)
+        {
+            parse_uci_setoption(cmd, board);
+        }
+        else if(cmd == "debug on") uci_debug = 1;
+        else if(cmd == "debug off") uci_debug = 0;
+        else if(cmd == "ucinewgame")
+        {
+            clear_uci_table(board);
+        }
+        else if(cmd == "uci")
+        {
+            print_uci_id();
+        }
         else if(cmd == "isready")
         {
             std::cout << "readyok" << std::endl;
@@ -104,44 +451,84 @@ void uci_loop()
     @return bool denoting whether parsing was successful.
 
     @warning Will return on error.
+    @warning Consecutive commands from the same game are applied
+             incrementally, so the board must not be changed between them
+             other than by a search, which always restores it.
 */
 
 bool parse_uci_position(const std::string& cmd, Board& board)
 {
     unsigned int i = 9;
 
-    if(cmd.compare(i, 8, "startpos") == 0) // Set start position.
+    if(cmd.size() <= i) return 0; // Parse error.
+
+    std::size_t moves_at = cmd.find("moves");
+    std::string base = cmd.substr(i, moves_at == std::string::npos ?
+        std::string::npos : moves_at - i);
+    std::vector<std::string> moves;
+
+    while(!base.empty() && isspace(base.back())) base.pop_back();
+
+    if(moves_at != std::string::npos) // Check for move list.
     {
-        i += 9;
-        unsigned int j = 0;
-        parse_fen(board, FEN_START, j);
+        std::string move_buf;
+        std::stringstream move_list(cmd.substr(moves_at + 5));
+
+        while(move_list >> move_buf) moves.push_back(move_buf);
     }
-    else if(cmd.compare(i, 3, "fen") == 0) // Initialise with FEN string.
+
+    // If the base position is unchanged and the new move list extends the
+    // one already on the board, only the new moves need to be made.
+
+    unsigned int first = 0;
+
+    if(!uci_base.empty() && base == uci_base &&
+        moves.size() >= uci_moves.size() &&
+        std::equal(uci_moves.begin(), uci_moves.end(), moves.begin()))
     {
-        i += 4;
-        parse_fen(board, cmd, i);
+        first = uci_moves.size();
     }
-    else return 0; // Parse error.
-
-    if(cmd.find("moves") != std::string::npos) // Check for move list.
+    else
     {
-        i = cmd.find("moves") + 6;
-
-        unsigned int move;
-        std::string move_buf;
-        assert(cmd[i]);
-        std::stringstream moves(cmd.substr(i));
+        uci_base.clear(); // Invalid until the position is fully set up.
+        uci_moves.clear();
 
-        while(moves >> move_buf)
+        if(cmd.compare(i, 8, "startpos") == 0) // Set start position.
         {
-            move = parse_move(board, move_buf);
+            unsigned int j = 0;
+            parse_fen(board, FEN_START, j);
+        }
+        else if(cmd.compare(i, 3, "fen") == 0) // Initialise with FEN string.
+        {
+            i += 4;
+            if(!parse_fen(board, cmd, i)) return 0; // Parse error.
+        }
+        else return 0; // Parse error.
+    }
 
-            if(move == NO_MOVE) return 0; // Parse error.
-            if(!make_move(board, move)) return 0; // Parse error.
+    for(unsigned int m = first; m < moves.size(); m++)
+    {
+        unsigned int move = parse_move(board, moves[m]);
+
+        if(move == NO_MOVE || !make_move(board, move)) // Parse error.
+        {
+            uci_base.clear();
+            uci_moves.clear();
+            return 0;
         }
     }
 
-    std::cout << std::endl << pretty_board(board) << std::endl << std::endl;
+    uci_base = base;
+    uci_moves.swap(moves);
+
+    if(uci_debug) // Print the board, line by line.
+    {
+        std::stringstream pretty(pretty_board(board));
+        std::string line;
+
+        while(std::getline(pretty, line))
+            if(!line.empty()) std::cout << "info string " << line << "\n";
+    }
 
     return 1;
 }
@@ -168,8 +555,11 @@ void parse_uci_go(const std::string& cmd, SearchInfo& search_info,
     int time_val = -1, move_time = -1, inc = 0;
 
     search_info.time_set = 0;
+    search_info.nodes_set = 0;
     search_info.stopped = 0;
     search_info.quit = 0;
+    search_info.soft_time = 0;
+    search_info.search_moves.clear();
 
     // Find every option in the string.
 
@@ -183,6 +573,12 @@ void parse_uci_go(const std::string& cmd, SearchInfo& search_info,
         depth = std::stoi(cmd.substr(cmd.find("depth") + 6));
     }
 
+    if(cmd.find("nodes") != std::string::npos)
+    {
+        search_info.nodes_set = 1;
+        search_info.max_nodes = std::stoull(cmd.substr(cmd.find("nodes") + 6));
+    }
+
     if(cmd.find("movestogo") != std::string::npos)
     {
         moves_to_go = std::stoi(cmd.substr(cmd.find("movestogo") + 10));
@@ -208,8 +604,28 @@ void parse_uci_go(const std::string& cmd, SearchInfo& search_info,
         inc = std::stoi(cmd.substr(cmd.find("binc") + 5));
     }
 
+    // 'searchmoves' is followed by every move to restrict the search to.
+
+    if(cmd.find("searchmoves") != std::string::npos)
+    {
+        std::stringstream moves(cmd.substr(cmd.find("searchmoves") + 11));
+        std::string str_move;
+        unsigned int move;
+
+        while(moves >> str_move)
+        {
+            move = parse_move(board, str_move);
+
+            if(move == NO_MOVE) break; // Not a move; another option.
+
+            search_info.search_moves.push_back(move);
+        }
+    }
+
     // Set up the search information structure.
 
+    int clock = time_val; // Time left on the clock, if any.
+
     if(move_time != -1)
     {
         time_val = move_time;
@@ -223,19 +639,45 @@ void parse_uci_go(const std::string& cmd, SearchInfo& search_info,
     {
         search_info.time_set = 1;
         time_val /= moves_to_go;
-        time_val -= 50;
-        search_info.move_time = time_val + inc;
+        time_val += inc;
+
+        // The overhead only comes off a clock. A fixed 'movetime' is the
+        // GUI's own budget for the move, so it's searched in full.
+
+        if(move_time == -1) time_val -= get_option("Move Overhead");
+
+        search_info.move_time = (time_val > 0) ? time_val : 1;
+
+        // Under a clock, that share of the time becomes a soft limit, and
+        // up to three times as much is spent if the best move keeps
+        // changing, though never more than half the clock.
+
+        if(move_time == -1)
+        {
+            int max_time = clock / 2 - get_option("Move Overhead");
+            uint64 hard_time = search_info.move_time * 3;
+
+            if(max_time < 1) max_time = 1;
+            if(hard_time > uint64(max_time)) hard_time = max_time;
+
+            search_info.soft_time = search_info.move_time < hard_time ?
+                search_info.move_time : hard_time;
+            search_info.move_time = hard_time;
+        }
     }
 
-    std::cout << "move_time " << search_info.move_time << " depth " <<
-        search_info.depth << " time_set ";
+    search_info.multi_pv = get_option("MultiPV");
+
+    search_info.debug = uci_debug;
 
-    if(search_info.time_set) std::cout << "true" << std::endl;
-    else std::cout << "false" << std::endl;
+    if(uci_debug)
+    {
+        std::cout << "info string move_time " << search_info.move_time <<
+            " depth " << search_info.depth << " time_set " <<
+            (search_info.time_set ? "true" : "false") << "\n";
+    }
 
     search_info.start_time = get_cur_time();
 
     search(board, search_info); // Search!
-
-    std::cout << std::endl;
 }
\ No newline at end of file
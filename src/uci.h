@@ -2,7 +2,7 @@
     Cortex - Self-learning Chess Engine
     @filename uci.h
     @author Shreyas Vinod
-    @version 1.0.0
+    @version 1.0.2
 
     @brief Includes everything needed to support the UCI
            (Universal Chess Interface) protocol.
@@ -11,6 +11,8 @@
     * 02/12/2015 File created.
     * 05/12/2015 0.1.0 Initial version.
     * 10/04/2017 1.0.0 Release 'Primeval'
+    * 17/10/2026 1.0.1 Added a typed option registry and 'setoption'.
+    * 17/10/2026 1.0.2 uci_loop() only replies to a 'uci' read before the loop when asked to.
 */
 
 /**
@@ -32,9 +34,75 @@
 #include "board.h"
 #include "search.h"
 
+// Enumerations
+
+enum { OPT_SPIN, OPT_CHECK, OPT_BUTTON, OPT_STRING }; // UCI option types.
+
+// Structures
+
+/**
+    @struct UciOption
+
+    @brief Holds an option the engine advertises to the GUI, and which the
+           GUI may change with 'setoption'.
+
+    @var UciOption::name
+         The name of the option, as advertised.
+    @var UciOption::type
+         The type of the option; OPT_SPIN, OPT_CHECK, OPT_BUTTON or
+         OPT_STRING.
+    @var UciOption::value
+         The current value of a spin or check option.
+    @var UciOption::def
+         The default value of a spin or check option.
+    @var UciOption::min
+         The minimum value of a spin option.
+    @var UciOption::max
+         The maximum value of a spin option.
+    @var UciOption::str_value
+         The current value of a string option.
+    @var UciOption::str_def
+         The default value of a string option.
+    @var UciOption::on_change
+         Called when the option is set (or the button pressed), with the
+         option and the board of the UCI loop, or null if nothing needs doing
+         beyond storing the value.
+*/
+
+struct UciOption
+{
+    std::string name;
+    unsigned int type;
+    int value;
+    int def;
+    int min;
+    int max;
+    std::string str_value;
+    std::string str_def;
+    void (*on_change)(const UciOption& option, Board& board);
+
+    UciOption(const std::string& n, unsigned int t, int d, int mn, int mx,
+        const std::string& sd, void (*oc)(const UciOption&, Board&))
+    :name(n), type(t), value(d), def(d), min(mn), max(mx), str_value(sd),
+        str_def(sd), on_change(oc)
+    {}
+};
+
 // External function declarations
 
-extern void uci_loop(); // UCI infinite loop.
+// Register the options and set them to their defaults.
+
+extern void init_uci_options(Board& board);
+
+// Get the value of a spin or check option.
+
+extern int get_option(const std::string& name);
+
+// Parses the UCI 'setoption' command.
+
+extern bool parse_uci_setoption(const std::string& cmd, Board& board);
+
+extern void uci_loop(bool greet); // UCI infinite loop.
 
 // Parses the UCI 'position' command.
 